@@ -0,0 +1,331 @@
+// 字符集预设数据，由 GB2312、Big5 码表生成，供 charsetAddPreset 使用。
+// 汉字部分为 U+4E00–U+9FFF 范围内的位图，每个 uint32_t 依次表示 32 个码位（低位在前）；
+// GB2312 1–9 区的非汉字符号为升序码位列表
+#ifndef CHARSET_PRESETS_H
+#define CHARSET_PRESETS_H
+
+#include <stdint.h>
+
+#define CHARSET_PRESET_CJK_BASE  0x4E00
+#define CHARSET_PRESET_CJK_WORDS 656
+
+// GB2312 一级汉字（16–55 区，3755 字）
+static const uint32_t gb2312Level1Bits[CHARSET_PRESET_CJK_WORDS] = {
+    0x3F5A6F8B, 0x6F152CB4, 0xE35DFB28, 0x400B0043, 0x0C36DB40, 0x84047BF6, 0x83FA6CE3, 0xA8C51438,
+    0xC783E402, 0x15518451, 0x1A2BE048, 0x80099209, 0x28802910, 0x8020C3E9, 0x61818418, 0x0402E202,
+    0x87142000, 0x54000442, 0x14008080, 0x80C00020, 0x00002121, 0x08041108, 0x04008000, 0x08280080,
+    0x00040000, 0x80000002, 0x14122B7A, 0x3BFB3924, 0x1AA43321, 0x08ED9011, 0x28029A51, 0xAF49A013,
+    0x2F8604CB, 0x2FC14B11, 0x0053240E, 0x800486A0, 0xE8000100, 0x800E0F0B, 0x81040A88, 0xC4000010,
+    0x22C00161, 0x8E00040B, 0x54EEC78A, 0x81BB8897, 0x85201A74, 0x88000344, 0x0BD23F06, 0x13CDFC79,
+    0xE8ABF71A, 0x5B32FBC1, 0x19210541, 0x39280104, 0x0265D841, 0x210A9100, 0x808263D3, 0x14046760,
+    0x000102C2, 0x4002D010, 0x00000458, 0x11004472, 0x31000695, 0x08880080, 0x10080020, 0x2000000A,
+    0x09004200, 0x88560000, 0x00004000, 0x00401500, 0x0000C000, 0x10800008, 0x4C000400, 0x64132015,
+    0x80000148, 0x44012108, 0xEC83E481, 0x00808453, 0x0804081C, 0x0000484C, 0x8010480C, 0x06000001,
+    0x00220044, 0x00210412, 0x41121000, 0x00000800, 0xC20C0028, 0x00000300, 0x00200002, 0x02495810,
+    0x9460A090, 0x0792CE80, 0x00D2CB90, 0x23580025, 0x024C05D4, 0x0A004120, 0x141B0840, 0x88001120,
+    0x9100009A, 0x00420221, 0x04000240, 0x80500400, 0x04040000, 0x00080000, 0x00001206, 0x00000202,
+    0x00000000, 0x00000000, 0xB3B10000, 0x24210658, 0x7F809BAA, 0xE2790C5F, 0xE00D10F4, 0x9F000122,
+    0x25528652, 0xF7020090, 0x4022CF27, 0x82028023, 0x08900006, 0x81082200, 0x02000000, 0x08012542,
+    0x00504080, 0x00002200, 0x00001000, 0x00000000, 0x00000000, 0x00000000, 0x60002000, 0x409E4BE6,
+    0x3D61116E, 0x210060C0, 0x00201024, 0xB95C0004, 0xD6B984D0, 0x01C020C0, 0x00480600, 0x04C00000,
+    0x89A8841D, 0x060280E1, 0x202C0000, 0x1A033654, 0x01850D33, 0x20804402, 0x03803068, 0xA8220881,
+    0x30744007, 0x080085A1, 0x00252808, 0x9049BB14, 0x80102210, 0x11049149, 0x90220C20, 0x0649EBC1,
+    0x84008302, 0x80000090, 0x00225100, 0x00810184, 0x00004800, 0x40000100, 0x00040504, 0x00000040,
+    0x0547F500, 0x80984400, 0x091E6883, 0xD249FAC8, 0x0DEE0611, 0xB2221937, 0x9B5D73F4, 0xF09AB3EC,
+    0xEC424286, 0x24008D3B, 0xC021F264, 0x08C0408E, 0x01459385, 0x058807AD, 0x0045A200, 0x2010260A,
+    0x50198027, 0x24003400, 0x011005D0, 0x03000280, 0x402600A4, 0x10217210, 0x40046024, 0x00000040,
+    0x01040001, 0xCA408800, 0x6A429120, 0x0095104C, 0x92821880, 0x2201A2B2, 0x00808822, 0x04C233E5,
+    0x8018D044, 0x5000A1A1, 0x042C1808, 0x4451C150, 0x00C20084, 0x00104000, 0x22000000, 0xD21D0000,
+    0xA8902B01, 0x2432BD00, 0x9043C24D, 0xC001A123, 0x34A10212, 0x00C08C0C, 0x501F8010, 0x801A9021,
+    0x00CA89A0, 0x33800402, 0x001B116C, 0x00400328, 0x00800062, 0x0009A1C4, 0x05242A01, 0x04224001,
+    0x00046020, 0xA0012000, 0x44100000, 0x10800000, 0x10100044, 0x00900100, 0x08010000, 0x20000000,
+    0x80000400, 0x00020402, 0x02000080, 0x00020002, 0x00000011, 0x00001000, 0x00000000, 0x00000000,
+    0x00000000, 0x4404008F, 0x00001280, 0x1A0004FC, 0x00400E48, 0x80B00000, 0x0AF4A822, 0x00008802,
+    0x885A8000, 0x0111C1C4, 0xE8A10287, 0x62050413, 0x8A00830E, 0xFB084CF2, 0x48201630, 0x3829052E,
+    0x48840802, 0x78060420, 0x060A4CE2, 0x01904640, 0xA8205324, 0x012487DA, 0x01421851, 0x0A8A5812,
+    0x20912420, 0x0510A21B, 0x09402008, 0xC0000000, 0x10010228, 0x04408404, 0x441A0882, 0x00100372,
+    0x00188044, 0x400A0801, 0x51002000, 0x00006040, 0x10004110, 0x00080002, 0x00040001, 0x00000000,
+    0x00020000, 0x00000000, 0x00001000, 0xD161A800, 0x02344600, 0x3308F000, 0x8B00010E, 0x2280BAD0,
+    0x06200600, 0x00410040, 0x40005000, 0x20004090, 0x82108410, 0x00001000, 0x00204008, 0x00000020,
+    0x00000040, 0x23E21400, 0x8A001180, 0x06240286, 0x00000403, 0x02409000, 0x42810114, 0x11037003,
+    0x18404000, 0xC0104E00, 0x00000000, 0x00002000, 0x08400A90, 0x08058A00, 0x00012400, 0x00002001,
+    0x00010268, 0x10780004, 0xC4000000, 0x00410000, 0x00000008, 0x00000000, 0x10000000, 0x00C0405C,
+    0x95000010, 0x09AF2B20, 0x12109020, 0x01100460, 0x86828040, 0x7224C832, 0x493407A0, 0x02110404,
+    0x80000002, 0x01100E50, 0x00001000, 0x69000008, 0x004208D4, 0x80024000, 0x89D7C564, 0x5114C000,
+    0x80000A02, 0x14C08301, 0x08000003, 0x0200184A, 0x00044030, 0x080816A0, 0x08800000, 0xE0086A2C,
+    0x04543006, 0x41910080, 0x20240021, 0x10805800, 0x81827200, 0x401B0080, 0x00210C22, 0x04800100,
+    0x00000002, 0x54000000, 0xE0400102, 0x01802120, 0x00008012, 0x6A000000, 0x81062A4B, 0x290182D0,
+    0x04806801, 0xB8080001, 0x00800040, 0x84D00000, 0xB1C6201A, 0x80000020, 0xC2400800, 0x8200A029,
+    0x08120840, 0x14001140, 0x08578A00, 0x42800000, 0x00B02001, 0x00022202, 0x020800C0, 0x00824002,
+    0x00000080, 0x80000080, 0x00002000, 0x28080000, 0x81A40200, 0x420A4430, 0x92600400, 0x08008001,
+    0x00000400, 0x00008885, 0x00000000, 0x00004000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000002, 0x00000000, 0x00000004, 0xA7EE9CD5, 0xF72EE5F8, 0xB1B926EC,
+    0x25784271, 0x05104301, 0x04A30000, 0x00044604, 0x44105400, 0x22000012, 0x81101022, 0x18030001,
+    0x03A1302B, 0xA9480400, 0x05101C04, 0x00000400, 0x2D401AD8, 0xC404C637, 0x5440504B, 0x25498002,
+    0x044B8644, 0x41028000, 0x00330C40, 0xCE014020, 0x39008401, 0x00080100, 0x0000004D, 0x18182408,
+    0xD0143061, 0x02E31400, 0x01000080, 0x440D8000, 0x30042804, 0x220AB060, 0xC892A080, 0x02028860,
+    0x0000403E, 0x03601980, 0x04150240, 0x0080889A, 0x00004240, 0x22860800, 0x10009480, 0x00060201,
+    0x20007010, 0x200001B0, 0x08800000, 0x0022180A, 0x12000804, 0x01040000, 0xA0420210, 0x00001000,
+    0x048A0000, 0x30801802, 0x00000600, 0x40100000, 0x08000010, 0x00008400, 0x00218200, 0x08000210,
+    0x00020000, 0x01000000, 0x4403C000, 0x62020800, 0x10201407, 0x00000010, 0x0A100CC1, 0x42014010,
+    0x11A40005, 0x00000002, 0x00804280, 0x00500000, 0x80002000, 0x04000000, 0x00000000, 0x02000000,
+    0x00200000, 0x00000004, 0x02903021, 0x0081192A, 0x10442812, 0x00022800, 0x02300026, 0x03180010,
+    0x00050004, 0x00000420, 0x80000010, 0x80000000, 0x00000042, 0x00000000, 0x00040376, 0x00000048,
+    0x00000001, 0x00000000, 0x00000000, 0x02000000, 0x00080600, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00001040, 0x00000000, 0xF74DEB3E, 0x6CA23773, 0x6DB6B8EE,
+    0x14896D6A, 0x0093335C, 0x00001042, 0x06000C06, 0x00001200, 0x00000000, 0x00000000, 0x00000000,
+    0xE0000000, 0xD7B3FFFE, 0x4D51DC1E, 0x00F1085F, 0x80000C22, 0x40180008, 0xA0021808, 0x04288500,
+    0x40009400, 0x00000604, 0x00000910, 0x80043040, 0x00000082, 0x04049800, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0xA811D3C0, 0xDAEB0768, 0x62030B08, 0xFB1341B6, 0x23812C04,
+    0xEC95864F, 0x59004005, 0x0088A086, 0x80206028, 0x000A0001, 0x0A22C44C, 0x20024402, 0x21102182,
+    0x02000004, 0x00000000, 0x64843A00, 0x81E25428, 0x0C040A80, 0x00000000, 0x1002F680, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00100000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xE20C4300, 0x482A43E7, 0x3000006F, 0x4547300A,
+    0x06831933, 0x0A01E17A, 0x10032483, 0x80412008, 0x00000000, 0x00000000, 0x00000000, 0x2F95E500,
+    0x90134227, 0x887C4000, 0x082139F1, 0x00E00716, 0x13118860, 0x40400080, 0x0020B0F3, 0x42C00500,
+    0x50482291, 0x03040000, 0x4A440000, 0x00580207, 0x01002800, 0x00002001, 0x00000000, 0x006822C0,
+    0x00000000, 0x00000000, 0x00000000, 0xEEE00000, 0x31CB05F6, 0x00000091, 0xC1004000, 0x00000000,
+    0x00010000, 0x00000000, 0x00000000, 0x9467E020, 0x02448962, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x5A5BF000, 0x048298D4, 0x01000112, 0x01080000, 0x00000000,
+    0x00000008, 0x10000000, 0x00108016, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x10000000, 0x10002002, 0x01000010, 0x40400008, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x80000000, 0xA028A06A, 0x00008428, 0x80010010, 0x00080000, 0x08000040, 0x01126010, 0x00000000,
+    0x00084000, 0x08000001, 0x00010000, 0x80000000, 0x86000810, 0x00000000, 0x00000000, 0x00000000,
+};
+
+// GB2312 二级汉字（56–87 区，3008 字）
+static const uint32_t gb2312Level2Bits[CHARSET_PRESET_CJK_WORDS] = {
+    0x40211000, 0x80401100, 0x10000080, 0x00000200, 0x81082000, 0x08280001, 0x6000021C, 0x00280902,
+    0x08000200, 0x200408A4, 0xE5800000, 0x585000B0, 0x00128208, 0x00001400, 0x94024020, 0x41080548,
+    0x10009000, 0x00007320, 0x00205108, 0x48001000, 0x00000000, 0x040002A0, 0x00400000, 0x00007040,
+    0x000008C0, 0x00000000, 0x00600001, 0x00004000, 0x00400006, 0x30020824, 0x00000080, 0x10200800,
+    0x00406104, 0x80082000, 0x50001001, 0x20000002, 0x00090006, 0x40003004, 0x00410000, 0x02010000,
+    0x0421A000, 0x40004040, 0x80000020, 0x04004248, 0x20002000, 0x00404028, 0x80000000, 0x28220300,
+    0x00440040, 0x0004000A, 0x02DC0808, 0x00C60050, 0x2C100014, 0x88102ED8, 0x763D9004, 0xA0080080,
+    0x08128000, 0x9089048D, 0x10610202, 0x48E03080, 0x8212890A, 0x62220000, 0xA0563210, 0x40AC9D70,
+    0xC0009103, 0x02003098, 0x13903000, 0x18020A14, 0x00080060, 0x00008000, 0xA0900000, 0x82200802,
+    0x10000610, 0x0A08D600, 0x10001004, 0x18482B00, 0x00081060, 0x01142293, 0x27248000, 0x2110A010,
+    0x42002881, 0x00000001, 0x00002010, 0x40001020, 0x04000203, 0x10000000, 0x00020020, 0x00000000,
+    0x02100004, 0x10002030, 0x05200006, 0x00000000, 0x4080200A, 0x40048E18, 0x21840400, 0x02000008,
+    0x000A1360, 0x10140008, 0x00200401, 0x04A00084, 0x08000000, 0x41240400, 0x11540000, 0x00020849,
+    0x00C00200, 0x00940000, 0x0C0A0001, 0x000A1024, 0x00280011, 0x01000020, 0x00000000, 0x00014010,
+    0x10200000, 0x08101024, 0x02010000, 0x04004048, 0x17433100, 0x20A2180C, 0x00040812, 0x00000030,
+    0x4800004C, 0x601040D0, 0x29000C80, 0x00109A00, 0x22000004, 0x00800000, 0x08000020, 0x20008000,
+    0x02128000, 0x18820000, 0x48100010, 0x04000002, 0x00420801, 0x42280021, 0x08060000, 0xC0100500,
+    0x00020902, 0x10002600, 0x01C10001, 0x00880002, 0x12201284, 0x10202100, 0x20478210, 0x41006412,
+    0x0A00A478, 0x90200A42, 0x26000006, 0x2F000488, 0x2C441008, 0x08122800, 0x25000040, 0x00101000,
+    0x00206041, 0x00000849, 0x20000400, 0x00200000, 0x20100000, 0x00801280, 0x00120800, 0x80200000,
+    0x88A00840, 0x60001036, 0x00001308, 0x00000400, 0x80000000, 0x08000000, 0x04800400, 0x00404000,
+    0x00000100, 0x02040004, 0x00000808, 0x04022200, 0x00004400, 0x50117000, 0x40004050, 0x81440001,
+    0x08001800, 0x80100043, 0x40040022, 0x04002000, 0x02400010, 0x05800000, 0x01810001, 0x00000014,
+    0x00000200, 0x01304020, 0x00200200, 0x00000800, 0x08090000, 0x10000800, 0x00445058, 0x0001C000,
+    0x22200409, 0x00720000, 0x80D08002, 0x00800002, 0x20001010, 0x42000180, 0x18000000, 0x00800240,
+    0x00210400, 0x00000040, 0x40081100, 0x10AC0600, 0x41000880, 0x012921A0, 0x2700000A, 0x20010204,
+    0x20005601, 0x400C0200, 0x00204613, 0x009008D7, 0x00088008, 0x00200000, 0x00000004, 0x12010008,
+    0x80010802, 0x02100011, 0x20800004, 0x03024849, 0x09202391, 0x08022880, 0x80105402, 0x80042001,
+    0x01800000, 0x60208100, 0x09010010, 0x12000020, 0x00834000, 0x00000A01, 0x00000000, 0x00000000,
+    0x00000000, 0x02800010, 0x02000048, 0x00000000, 0x0C0C2096, 0x00080402, 0x00080004, 0x22280400,
+    0x072120E0, 0x20240612, 0x10100440, 0x00500300, 0x00191060, 0x00062208, 0x00D90000, 0x45C2C801,
+    0x06005090, 0x02284880, 0x5014A108, 0x10008009, 0x401A0000, 0x80004801, 0x620000A0, 0x10000041,
+    0x04425000, 0x00040820, 0x80184010, 0x00004800, 0x81008040, 0x289600A0, 0x80A08004, 0x02000005,
+    0x00200200, 0x0040A610, 0x000008C0, 0x15140004, 0x00003200, 0x02400080, 0x40020204, 0x0000C003,
+    0x0C000000, 0x02200008, 0x40008000, 0x00001000, 0x30400021, 0x08820800, 0x00000401, 0x00000100,
+    0x01490000, 0x00028000, 0x10000420, 0x050C0140, 0x01000000, 0x02280101, 0x00100000, 0x02004081,
+    0x20000000, 0x88010100, 0x20442000, 0xC000C040, 0x8004A810, 0x01912000, 0x0004600A, 0x0C9C8300,
+    0x60A8040A, 0x03821026, 0x00852000, 0x40009001, 0x80024000, 0x04884004, 0x42028305, 0x000402A0,
+    0x0C008400, 0x00015560, 0x1AA00002, 0x40802000, 0x50014883, 0x04000380, 0x40040000, 0x80108001,
+    0x020AA000, 0x44009000, 0x0C004901, 0x82040000, 0x20540808, 0x011B1009, 0x0040201C, 0x900209D8,
+    0x0BA11429, 0xD0292025, 0x50502009, 0x00008800, 0x02084100, 0x00140010, 0x00002000, 0x02020020,
+    0x06002190, 0x01202044, 0x04030088, 0xE0000124, 0x80023001, 0xA0210005, 0x10002000, 0x01401080,
+    0xB1820201, 0x1E003268, 0x00C15080, 0x00002400, 0x1C080080, 0x0204002A, 0x02100200, 0x00141000,
+    0x40080020, 0x08100010, 0x1C880241, 0x04008085, 0x04000421, 0x04080080, 0x00200000, 0x00002808,
+    0x4010004C, 0x02800008, 0x00020000, 0x03010000, 0x00200141, 0x00083141, 0x00000000, 0x24000040,
+    0x42208518, 0x410A4C31, 0x250010A0, 0x08264005, 0x30010020, 0x01101DC4, 0x24021002, 0x50000460,
+    0x80409800, 0x01000440, 0x00000003, 0x10100000, 0x70020000, 0x30040004, 0x008031A2, 0x01000100,
+    0x00000000, 0x00000000, 0x00000000, 0x00800000, 0x00000000, 0x00004040, 0x00000000, 0x00000000,
+    0x00000000, 0x08000000, 0x00000080, 0x00000000, 0x88000000, 0x4001232A, 0x08911A07, 0x4C46C903,
+    0x9A86B98E, 0x006FBCFE, 0x81100034, 0x42120102, 0xA0000002, 0x91058080, 0x00204400, 0x00084262,
+    0x10540850, 0x00A203E5, 0x00042048, 0x80020200, 0x90080001, 0x30922800, 0x2A802014, 0x10163FB0,
+    0x41146000, 0x00441000, 0x06081100, 0x30122281, 0x00020104, 0x0C000448, 0x00001402, 0x40001080,
+    0x08010016, 0x4918A90E, 0x84008A10, 0xA2104100, 0x8382C510, 0x41914F12, 0x112C5D12, 0x0890001B,
+    0x1CB293C0, 0x141AA000, 0xD8028089, 0x39007761, 0x590C0020, 0x15590701, 0xA1500023, 0x23010422,
+    0x1102884A, 0x11020040, 0x16020040, 0x05482200, 0x00805380, 0xA6108002, 0x00092402, 0x90010069,
+    0x80001000, 0x0F000000, 0x42400108, 0x0E040110, 0x100080A0, 0x02814110, 0x10080002, 0x80000000,
+    0x00400020, 0x10000280, 0x00102000, 0x9C005004, 0x20082800, 0x04739788, 0xC103C210, 0x011E2200,
+    0x44082788, 0xC892422C, 0x02081100, 0x78014039, 0x0088092C, 0x2028B900, 0x080E0C41, 0x40004421,
+    0x08480408, 0x12040002, 0x00000010, 0xE0044214, 0x00000124, 0x10800014, 0x81044240, 0x5003012C,
+    0x0E080400, 0x00510802, 0x40000002, 0x08000040, 0x00000008, 0x00000000, 0x5443DC80, 0x00088820,
+    0x00000080, 0x40000000, 0x00000100, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000080, 0x00000040, 0x00000000, 0x00000000, 0x00000000, 0x00B004C1, 0x935CC80C, 0x92494311,
+    0xAB769095, 0x006CCCA3, 0x04200280, 0x01080000, 0x01100424, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x284C0000, 0x322823E1, 0x00082080, 0x00120010, 0x95220000, 0x4CC0C050, 0x2B801818,
+    0xA0100220, 0x2622D008, 0x02060687, 0x10518200, 0x50118020, 0x00000000, 0x00004000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x57EE2800, 0x0510E896, 0x00400000, 0x00280000, 0x00084370,
+    0x00422830, 0x0060A042, 0x09070010, 0x20100104, 0x2AA0090C, 0x45591002, 0x188980B0, 0x40008844,
+    0x40000010, 0x0202800C, 0x0001C448, 0x62158216, 0x00033020, 0x0430E40C, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00004000, 0x00004000, 0x00000100, 0x00000000,
+    0x00000000, 0x40000000, 0x00000000, 0x00000400, 0x00008000, 0x00000000, 0x00400400, 0x00000000,
+    0x00000000, 0x40000000, 0x00000000, 0x00000800, 0x1CB1BCE0, 0xB7D5BC18, 0xCBE77F10, 0xB2B8CFB5,
+    0xE97CE6CC, 0xD5F61E04, 0xEBDCD274, 0x000E9FF6, 0x00000000, 0x00000000, 0x00000000, 0x506A0A00,
+    0x26E4BD58, 0x30020406, 0x80100204, 0x00141080, 0x00802100, 0x32090000, 0x00044200, 0x00088201,
+    0x0000C142, 0x40012400, 0x00080000, 0x10000020, 0x00160020, 0x00148808, 0x00000000, 0x00001C00,
+    0x00000000, 0x00000000, 0x00000000, 0x11000000, 0xCC10B209, 0x00000066, 0x062E0000, 0x00000180,
+    0x00002000, 0x00004000, 0x00300000, 0x20901F88, 0x01BB2491, 0x00000120, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0xA5A00000, 0xF94D0523, 0x14C300AD, 0x80021827, 0x0A00A842,
+    0x80088100, 0x08048008, 0x000223A8, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x80000000, 0xCC3749E4, 0x3CFF6BEF, 0xB3B9FCF0, 0x00000004,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x47C61F05, 0x5DA25BD6, 0x400A3FC8, 0xA0040984, 0x61100000, 0xB8008200, 0x5A0086A5,
+    0x02812800, 0x62809004, 0x00020010, 0x00000000, 0x080017E9, 0x00000001, 0x00000000, 0x00000000,
+};
+
+// Big5 常用字（A440–C67E，5401 字）
+static const uint32_t big5CommonBits[CHARSET_PRESET_CJK_WORDS] = {
+    0xC3732F0B, 0x0B052840, 0xE34CE928, 0x40080200, 0xCA365944, 0x04087976, 0xC3F02CDB, 0xA84D0038,
+    0x0223AE02, 0x35518000, 0x7EB3E1C8, 0xCC299209, 0x2842A948, 0x80E0C000, 0xE583C41C, 0x450AC003,
+    0x8756BA41, 0x10002F6A, 0x1420D288, 0x24F0A020, 0x07422021, 0x48ACB004, 0x0462C0A0, 0x0A2262A0,
+    0x81350335, 0x998C0402, 0x10B43BFB, 0x11E27BA4, 0x00A62601, 0x20C11435, 0x30003840, 0x274B0003,
+    0x20C645CB, 0x0DC14730, 0x38507C8A, 0xA0B48600, 0x880A278C, 0x48001E09, 0xEBA4028A, 0xCD29005C,
+    0x22E1A160, 0xC202840B, 0x549E07AB, 0x8BABC043, 0xA4000010, 0x08042020, 0x88D02F08, 0x192FFF7C,
+    0xE807FF5A, 0x5B6A7AC1, 0x0000454D, 0x39EA0104, 0x04655851, 0xA90A9FC0, 0x00004397, 0x34046762,
+    0x001182C2, 0x418AD080, 0xD0E0845A, 0x5800045A, 0xB7100E9D, 0x080E5C80, 0x940A42E0, 0x60C0817A,
+    0x88D16341, 0x8A55C200, 0x02884000, 0x03529F34, 0x0021C0A1, 0x10D04120, 0x6C021707, 0x84010C11,
+    0x814C2B18, 0x4809B300, 0x0003E481, 0x10800652, 0x0008080C, 0x0000400D, 0x8010480C, 0x06800011,
+    0x20000664, 0x00338413, 0x45961C00, 0x62202804, 0xD0080429, 0x40084340, 0xC32A40A2, 0x26009A14,
+    0x16708000, 0x41826EB5, 0x05B3C390, 0x23586685, 0x624C241E, 0x4A08C138, 0x151F2C60, 0x88001568,
+    0x990A120A, 0x10400229, 0x04000643, 0x80800444, 0x0C040000, 0x700C0080, 0x01C01206, 0x0820024A,
+    0x20001B00, 0x01110410, 0xBDBB0009, 0xA52B0A18, 0x1F809BA8, 0x8379407C, 0xC00D10F4, 0x05615BF6,
+    0x0442EF92, 0xD7821014, 0x3123E963, 0x02029135, 0x00131000, 0x018A0A02, 0x02040000, 0x28512500,
+    0x0AD240C2, 0x00100294, 0x00011080, 0x00008200, 0x20100090, 0x35000000, 0x60542200, 0x609E49E6,
+    0xAD62104C, 0x21C82820, 0x88B01029, 0x7B5C080E, 0x14E08480, 0x41E028C1, 0xA4480716, 0xC4C8100D,
+    0x89BC8D12, 0x10A222C0, 0x22805540, 0x92833E34, 0x53871FA3, 0x22A05703, 0x23C03028, 0xA1220C01,
+    0x2874C000, 0x00208FA3, 0x02212048, 0x8001BF3C, 0x84503230, 0x39740109, 0x952208E0, 0x0E5B0043,
+    0x9C24E343, 0xC0900088, 0xA5207990, 0x50E1498C, 0x04134404, 0x40445A90, 0x00002F84, 0xD5E40048,
+    0x8C677501, 0xC05D4406, 0x091E6B83, 0xD248E008, 0x01EE0651, 0xB2221900, 0x1FDD7BD4, 0xF09AF000,
+    0x00420386, 0x64008D00, 0x0021F244, 0x0CC60B80, 0x0B449319, 0x000017AF, 0x0C45A241, 0x0210660A,
+    0x50D8A040, 0x60503400, 0x81160000, 0x0F00A280, 0x462D0180, 0xD80D7A34, 0x05146CB6, 0x4C973045,
+    0x33108041, 0xCB409C18, 0x63F28320, 0x01B4104C, 0x9AA3008C, 0x328198B2, 0x00C0D822, 0x04023364,
+    0x8038D4C5, 0x0002A1B1, 0x6404922E, 0x44D1C150, 0x21C22390, 0x03124904, 0x324002D0, 0xD39D1241,
+    0xA8B02B09, 0x20327DC0, 0xD0CBC240, 0xD0AFA401, 0x34A90A80, 0x01518000, 0x661F8010, 0x803A9224,
+    0x01880000, 0x33000602, 0x001B116F, 0x80400000, 0xA098006E, 0x002BA186, 0x85A42A10, 0x0E244089,
+    0x00046020, 0x00010000, 0x6C180400, 0x02A06909, 0x18300044, 0x08906948, 0x0009380A, 0x20082100,
+    0xC20A0426, 0x2720000A, 0x83000990, 0x40000806, 0x10910011, 0x0908D00D, 0x2C08000C, 0x0C001020,
+    0x00410410, 0x6404000B, 0x92015280, 0x8B8404FE, 0x01400648, 0x94A4C010, 0x0C9CA861, 0x20009800,
+    0x884B8120, 0x4118D9D8, 0xEAA16007, 0x64550503, 0x0B55336E, 0xFB0A5800, 0x18E81632, 0x002B812F,
+    0x48805800, 0x6B664EA0, 0x06000002, 0x03905660, 0x003857A0, 0x9124C400, 0x470618F0, 0x0EAA5D52,
+    0x2E000020, 0x4514B07B, 0x89506418, 0x0004C288, 0x31410200, 0x14508CA4, 0x003A18B4, 0xC0949000,
+    0x00388046, 0xC10E9E0D, 0x89120000, 0x1501E051, 0x00804151, 0x025A00D3, 0x8920000F, 0x4403DA13,
+    0xAD228A40, 0x40050100, 0x41021000, 0x31410818, 0x02244400, 0x0508F810, 0x03008500, 0x22008010,
+    0x16000600, 0x00410042, 0x52405240, 0x200053F0, 0x82140410, 0x42021100, 0x92254318, 0x591070E1,
+    0x08012040, 0x6F613500, 0xAB4411C0, 0x22148287, 0x08440013, 0x00009084, 0x02814015, 0x33800203,
+    0x1A480000, 0xC0D00220, 0x00814030, 0x0DA50100, 0x80400AD1, 0x088C0B20, 0x40002401, 0x40006401,
+    0x08002668, 0x84788564, 0xDE200002, 0x4001A618, 0xD1000809, 0xA00103C8, 0x14508400, 0x00C0005D,
+    0x95203010, 0x218F3B64, 0x3610D800, 0x81410C64, 0x26028CC0, 0x732C083C, 0x4B3024A4, 0x841F000D,
+    0x80082A03, 0x051002D7, 0x81441044, 0x79065226, 0x044849D4, 0x84114000, 0xD814656C, 0x5314C4BA,
+    0x80000A82, 0x55C00301, 0x58008000, 0xA2001D6E, 0xC0025890, 0xB80934A1, 0x1C880080, 0x2008E22C,
+    0xA0103004, 0x019520A1, 0x20004008, 0x90009800, 0x818A5200, 0x54090288, 0x04210C22, 0x04909180,
+    0x02004002, 0x44001C40, 0xE4E103C3, 0x84002121, 0x0000E002, 0xE60A44C0, 0x81060B03, 0x080002D8,
+    0xD4102921, 0xB8824001, 0x00807841, 0x86500A07, 0x81E40112, 0x8400C601, 0x82000CB0, 0xA640A029,
+    0x4A020040, 0x00005141, 0x0057AA40, 0x00A04081, 0x20B08890, 0x01122003, 0x0A0012D3, 0x40800253,
+    0x40023080, 0xE1800C8A, 0x80013009, 0x200C5039, 0x80A40200, 0x622A0020, 0xF2600400, 0x49018085,
+    0x1EB12EF5, 0x120FC807, 0x4821005D, 0x020F4146, 0x500A8002, 0xED373005, 0x67040480, 0x0A149309,
+    0x68030700, 0xE2B6C808, 0x4634016A, 0x32082E02, 0x10589004, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x25400000, 0x80311110, 0x02A54600, 0x44105D20, 0xB3448310, 0x80345022, 0x1A0B4203,
+    0x13A7387B, 0xA0480140, 0x45440440, 0xE0CF8000, 0x2D481AF0, 0x04168E26, 0x6C405018, 0x311BA032,
+    0x00400564, 0x42018A18, 0x003B5840, 0x871B4860, 0x3D008505, 0xE4080301, 0x8500A24D, 0x5C1835AC,
+    0xD81537A5, 0x02E01D04, 0x03000880, 0x4086C040, 0xA2042800, 0x6B8BB028, 0xD89E0000, 0x000280E8,
+    0x0080027E, 0x03760900, 0x00158609, 0x19800000, 0x414C4640, 0x20000885, 0x90101422, 0x21178201,
+    0x00007C98, 0x31221000, 0x08800240, 0x00A03A4A, 0x52010004, 0x91040000, 0x000A0E51, 0x80005000,
+    0x049A0040, 0x2000302A, 0x42000708, 0x40002700, 0x18120490, 0x06018740, 0x2021A200, 0x0E800630,
+    0x04820CC0, 0x81002000, 0xD8314000, 0x0E020880, 0x10081400, 0x00628618, 0xCA110AD1, 0x4A002010,
+    0x110805CD, 0x88900224, 0x02A81000, 0x01500141, 0xC000200C, 0x0C080804, 0x00060941, 0x4A049001,
+    0x80302020, 0x0A42000E, 0x2A883001, 0x2281090E, 0x40442906, 0x00020800, 0xB3340406, 0x23188102,
+    0x042D0484, 0x29440C22, 0xC0400010, 0x80049411, 0x1048884A, 0x24041440, 0x00140001, 0x11100008,
+    0xA9EBD50D, 0x5C52242C, 0x48710042, 0x1A0F7B4D, 0x452A30A0, 0x924505FB, 0x18442A94, 0x55CA68C0,
+    0x2A814417, 0x02001901, 0x9700C242, 0x20919840, 0x144C0401, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x80800000, 0x04315342, 0x06083C06, 0x60083604, 0xB9DC9F87, 0x500E05BF, 0x3D10345F,
+    0x08C8A520, 0x00000000, 0x00000000, 0x009928D0, 0x82200422, 0x44180108, 0xAC025840, 0x14088552,
+    0xE0018000, 0x02320A06, 0x82200F14, 0x14541058, 0x000A2EA6, 0x04041C02, 0x8814BC01, 0x59000000,
+    0xF83C0608, 0xC9088660, 0x80106234, 0x00000002, 0x98000000, 0x0007E148, 0x00124074, 0x25912D74,
+    0xEEF1A06B, 0x5166400D, 0x7B3BEC86, 0xB5B4630D, 0x00238D9F, 0x0162044C, 0x2000440A, 0x60202106,
+    0x43840204, 0x02132080, 0x00843F00, 0x01B01628, 0x50040A88, 0x04125808, 0x3383FAE3, 0x002022C8,
+    0x40332280, 0xE3900008, 0x0C822A21, 0x19000010, 0x114A0021, 0x188C1100, 0x000400A2, 0x11010410,
+    0x07210010, 0x0048C947, 0x0C102C00, 0x40211020, 0x05D00404, 0x00095004, 0xB1C22108, 0x20000116,
+    0x01000008, 0x052C4800, 0x00060010, 0xF0850419, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00800000, 0x011ECA0D, 0x0802233A, 0x10711D40, 0x00000006,
+    0x10000000, 0x88065402, 0x69013815, 0x21FD141E, 0x1B306C70, 0x0B120580, 0x5A643EF3, 0x0AC4870C,
+    0x504AE2D1, 0x63050490, 0x58440114, 0x10500347, 0x0100A820, 0x00002049, 0x10081A4A, 0x8A482000,
+    0x118F156E, 0x0B812812, 0x4908F040, 0x000388A0, 0x00000000, 0x144A8100, 0x88000010, 0x7014A684,
+    0x4D0D1628, 0xE0204102, 0x50A60220, 0x00000000, 0x02400000, 0x001A7120, 0xAA270002, 0x80022004,
+    0x02404002, 0x40A10800, 0x8CA02029, 0x00000424, 0x00000000, 0x11818100, 0x015E8002, 0x0800E042,
+    0x04002048, 0x100601AC, 0x0512E036, 0x00808000, 0x00020000, 0x00006C00, 0x08400701, 0x20000180,
+    0x00082000, 0x48022020, 0x80D00200, 0x01800000, 0x00000000, 0x00000000, 0x00000000, 0x00580220,
+    0x08240248, 0x88000148, 0x20020000, 0x00041403, 0x00000200, 0x01108000, 0x00880004, 0x06000020,
+    0x4C000000, 0x00000000, 0x00000000, 0xB2200000, 0xA08C0804, 0x58300220, 0x7912F008, 0x00908101,
+    0x02284080, 0x48109001, 0x90040C00, 0x008414CA, 0x10112000, 0x00000000, 0x00000000, 0x00000000,
+};
+
+// GB2312 非汉字符号（1–9 区，682 个）
+static const uint16_t gb2312Symbols[] = {
+    0x00A4, 0x00A7, 0x00A8, 0x00B0, 0x00B1, 0x00D7, 0x00E0, 0x00E1, 0x00E8, 0x00E9, 0x00EA, 0x00EC,
+    0x00ED, 0x00F2, 0x00F3, 0x00F7, 0x00F9, 0x00FA, 0x00FC, 0x0101, 0x0113, 0x011B, 0x012B, 0x014D,
+    0x016B, 0x01CE, 0x01D0, 0x01D2, 0x01D4, 0x01D6, 0x01D8, 0x01DA, 0x01DC, 0x02C7, 0x02C9, 0x0391,
+    0x0392, 0x0393, 0x0394, 0x0395, 0x0396, 0x0397, 0x0398, 0x0399, 0x039A, 0x039B, 0x039C, 0x039D,
+    0x039E, 0x039F, 0x03A0, 0x03A1, 0x03A3, 0x03A4, 0x03A5, 0x03A6, 0x03A7, 0x03A8, 0x03A9, 0x03B1,
+    0x03B2, 0x03B3, 0x03B4, 0x03B5, 0x03B6, 0x03B7, 0x03B8, 0x03B9, 0x03BA, 0x03BB, 0x03BC, 0x03BD,
+    0x03BE, 0x03BF, 0x03C0, 0x03C1, 0x03C3, 0x03C4, 0x03C5, 0x03C6, 0x03C7, 0x03C8, 0x03C9, 0x0401,
+    0x0410, 0x0411, 0x0412, 0x0413, 0x0414, 0x0415, 0x0416, 0x0417, 0x0418, 0x0419, 0x041A, 0x041B,
+    0x041C, 0x041D, 0x041E, 0x041F, 0x0420, 0x0421, 0x0422, 0x0423, 0x0424, 0x0425, 0x0426, 0x0427,
+    0x0428, 0x0429, 0x042A, 0x042B, 0x042C, 0x042D, 0x042E, 0x042F, 0x0430, 0x0431, 0x0432, 0x0433,
+    0x0434, 0x0435, 0x0436, 0x0437, 0x0438, 0x0439, 0x043A, 0x043B, 0x043C, 0x043D, 0x043E, 0x043F,
+    0x0440, 0x0441, 0x0442, 0x0443, 0x0444, 0x0445, 0x0446, 0x0447, 0x0448, 0x0449, 0x044A, 0x044B,
+    0x044C, 0x044D, 0x044E, 0x044F, 0x0451, 0x2015, 0x2016, 0x2018, 0x2019, 0x201C, 0x201D, 0x2026,
+    0x2030, 0x2032, 0x2033, 0x203B, 0x2103, 0x2116, 0x2160, 0x2161, 0x2162, 0x2163, 0x2164, 0x2165,
+    0x2166, 0x2167, 0x2168, 0x2169, 0x216A, 0x216B, 0x2190, 0x2191, 0x2192, 0x2193, 0x2208, 0x220F,
+    0x2211, 0x221A, 0x221D, 0x221E, 0x2220, 0x2225, 0x2227, 0x2228, 0x2229, 0x222A, 0x222B, 0x222E,
+    0x2234, 0x2235, 0x2236, 0x2237, 0x223D, 0x2248, 0x224C, 0x2260, 0x2261, 0x2264, 0x2265, 0x226E,
+    0x226F, 0x2299, 0x22A5, 0x2312, 0x2460, 0x2461, 0x2462, 0x2463, 0x2464, 0x2465, 0x2466, 0x2467,
+    0x2468, 0x2469, 0x2474, 0x2475, 0x2476, 0x2477, 0x2478, 0x2479, 0x247A, 0x247B, 0x247C, 0x247D,
+    0x247E, 0x247F, 0x2480, 0x2481, 0x2482, 0x2483, 0x2484, 0x2485, 0x2486, 0x2487, 0x2488, 0x2489,
+    0x248A, 0x248B, 0x248C, 0x248D, 0x248E, 0x248F, 0x2490, 0x2491, 0x2492, 0x2493, 0x2494, 0x2495,
+    0x2496, 0x2497, 0x2498, 0x2499, 0x249A, 0x249B, 0x2500, 0x2501, 0x2502, 0x2503, 0x2504, 0x2505,
+    0x2506, 0x2507, 0x2508, 0x2509, 0x250A, 0x250B, 0x250C, 0x250D, 0x250E, 0x250F, 0x2510, 0x2511,
+    0x2512, 0x2513, 0x2514, 0x2515, 0x2516, 0x2517, 0x2518, 0x2519, 0x251A, 0x251B, 0x251C, 0x251D,
+    0x251E, 0x251F, 0x2520, 0x2521, 0x2522, 0x2523, 0x2524, 0x2525, 0x2526, 0x2527, 0x2528, 0x2529,
+    0x252A, 0x252B, 0x252C, 0x252D, 0x252E, 0x252F, 0x2530, 0x2531, 0x2532, 0x2533, 0x2534, 0x2535,
+    0x2536, 0x2537, 0x2538, 0x2539, 0x253A, 0x253B, 0x253C, 0x253D, 0x253E, 0x253F, 0x2540, 0x2541,
+    0x2542, 0x2543, 0x2544, 0x2545, 0x2546, 0x2547, 0x2548, 0x2549, 0x254A, 0x254B, 0x25A0, 0x25A1,
+    0x25B2, 0x25B3, 0x25C6, 0x25C7, 0x25CB, 0x25CE, 0x25CF, 0x2605, 0x2606, 0x2640, 0x2642, 0x3000,
+    0x3001, 0x3002, 0x3003, 0x3005, 0x3008, 0x3009, 0x300A, 0x300B, 0x300C, 0x300D, 0x300E, 0x300F,
+    0x3010, 0x3011, 0x3013, 0x3014, 0x3015, 0x3016, 0x3017, 0x3041, 0x3042, 0x3043, 0x3044, 0x3045,
+    0x3046, 0x3047, 0x3048, 0x3049, 0x304A, 0x304B, 0x304C, 0x304D, 0x304E, 0x304F, 0x3050, 0x3051,
+    0x3052, 0x3053, 0x3054, 0x3055, 0x3056, 0x3057, 0x3058, 0x3059, 0x305A, 0x305B, 0x305C, 0x305D,
+    0x305E, 0x305F, 0x3060, 0x3061, 0x3062, 0x3063, 0x3064, 0x3065, 0x3066, 0x3067, 0x3068, 0x3069,
+    0x306A, 0x306B, 0x306C, 0x306D, 0x306E, 0x306F, 0x3070, 0x3071, 0x3072, 0x3073, 0x3074, 0x3075,
+    0x3076, 0x3077, 0x3078, 0x3079, 0x307A, 0x307B, 0x307C, 0x307D, 0x307E, 0x307F, 0x3080, 0x3081,
+    0x3082, 0x3083, 0x3084, 0x3085, 0x3086, 0x3087, 0x3088, 0x3089, 0x308A, 0x308B, 0x308C, 0x308D,
+    0x308E, 0x308F, 0x3090, 0x3091, 0x3092, 0x3093, 0x30A1, 0x30A2, 0x30A3, 0x30A4, 0x30A5, 0x30A6,
+    0x30A7, 0x30A8, 0x30A9, 0x30AA, 0x30AB, 0x30AC, 0x30AD, 0x30AE, 0x30AF, 0x30B0, 0x30B1, 0x30B2,
+    0x30B3, 0x30B4, 0x30B5, 0x30B6, 0x30B7, 0x30B8, 0x30B9, 0x30BA, 0x30BB, 0x30BC, 0x30BD, 0x30BE,
+    0x30BF, 0x30C0, 0x30C1, 0x30C2, 0x30C3, 0x30C4, 0x30C5, 0x30C6, 0x30C7, 0x30C8, 0x30C9, 0x30CA,
+    0x30CB, 0x30CC, 0x30CD, 0x30CE, 0x30CF, 0x30D0, 0x30D1, 0x30D2, 0x30D3, 0x30D4, 0x30D5, 0x30D6,
+    0x30D7, 0x30D8, 0x30D9, 0x30DA, 0x30DB, 0x30DC, 0x30DD, 0x30DE, 0x30DF, 0x30E0, 0x30E1, 0x30E2,
+    0x30E3, 0x30E4, 0x30E5, 0x30E6, 0x30E7, 0x30E8, 0x30E9, 0x30EA, 0x30EB, 0x30EC, 0x30ED, 0x30EE,
+    0x30EF, 0x30F0, 0x30F1, 0x30F2, 0x30F3, 0x30F4, 0x30F5, 0x30F6, 0x30FB, 0x3105, 0x3106, 0x3107,
+    0x3108, 0x3109, 0x310A, 0x310B, 0x310C, 0x310D, 0x310E, 0x310F, 0x3110, 0x3111, 0x3112, 0x3113,
+    0x3114, 0x3115, 0x3116, 0x3117, 0x3118, 0x3119, 0x311A, 0x311B, 0x311C, 0x311D, 0x311E, 0x311F,
+    0x3120, 0x3121, 0x3122, 0x3123, 0x3124, 0x3125, 0x3126, 0x3127, 0x3128, 0x3129, 0x3220, 0x3221,
+    0x3222, 0x3223, 0x3224, 0x3225, 0x3226, 0x3227, 0x3228, 0x3229, 0xFF01, 0xFF02, 0xFF03, 0xFF04,
+    0xFF05, 0xFF06, 0xFF07, 0xFF08, 0xFF09, 0xFF0A, 0xFF0B, 0xFF0C, 0xFF0D, 0xFF0E, 0xFF0F, 0xFF10,
+    0xFF11, 0xFF12, 0xFF13, 0xFF14, 0xFF15, 0xFF16, 0xFF17, 0xFF18, 0xFF19, 0xFF1A, 0xFF1B, 0xFF1C,
+    0xFF1D, 0xFF1E, 0xFF1F, 0xFF20, 0xFF21, 0xFF22, 0xFF23, 0xFF24, 0xFF25, 0xFF26, 0xFF27, 0xFF28,
+    0xFF29, 0xFF2A, 0xFF2B, 0xFF2C, 0xFF2D, 0xFF2E, 0xFF2F, 0xFF30, 0xFF31, 0xFF32, 0xFF33, 0xFF34,
+    0xFF35, 0xFF36, 0xFF37, 0xFF38, 0xFF39, 0xFF3A, 0xFF3B, 0xFF3C, 0xFF3D, 0xFF3E, 0xFF3F, 0xFF40,
+    0xFF41, 0xFF42, 0xFF43, 0xFF44, 0xFF45, 0xFF46, 0xFF47, 0xFF48, 0xFF49, 0xFF4A, 0xFF4B, 0xFF4C,
+    0xFF4D, 0xFF4E, 0xFF4F, 0xFF50, 0xFF51, 0xFF52, 0xFF53, 0xFF54, 0xFF55, 0xFF56, 0xFF57, 0xFF58,
+    0xFF59, 0xFF5A, 0xFF5B, 0xFF5C, 0xFF5D, 0xFF5E, 0xFFE0, 0xFFE1, 0xFFE3, 0xFFE5,
+};
+
+#endif // CHARSET_PRESETS_H
@@ -0,0 +1,13 @@
+#!/bin/sh
+# 编译并运行回归测试，需在仓库根目录执行：sh tests/run.sh
+# 设置 SANITIZE=1 时启用 AddressSanitizer 和 UndefinedBehaviorSanitizer
+set -e
+cd "$(dirname "$0")/.."
+CFLAGS="-std=c11 -O1 -g -Wall -Wno-unused-function -Wno-unused-variable"
+if [ "$SANITIZE" = "1" ]; then
+    CFLAGS="$CFLAGS -fsanitize=address,undefined -fno-omit-frame-pointer"
+fi
+mkdir -p tests/out
+${CC:-gcc} $CFLAGS tests/test_ttf2bin.c -o tests/out/test_ttf2bin -lm -lpthread
+./tests/out/test_ttf2bin > tests/out/test_ttf2bin.log || { tail -n 40 tests/out/test_ttf2bin.log; exit 1; }
+tail -n 1 tests/out/test_ttf2bin.log
@@ -0,0 +1,700 @@
+// ttf2bin 回归测试：直接包含 ttf2bin.c，调用内部函数生成并读回 bin 文件。
+// 在仓库根目录运行 tests/run.sh；生成的临时文件写在 tests/out 下。
+#define main ttf2bin_main
+#include "../ttf2bin.c"
+#undef main
+
+#define OUT_DIR "tests/out"
+
+static const char *asciiText = "!\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
+static const char *twgxAsciiText = "滕王高阁临江渚，佩玉鸣鸾罢歌舞。画栋朝飞南浦云，珠帘暮卷西山雨。闲云潭影日悠悠，物换星移几度秋。阁中帝子今何在？槛外长江空自流。!\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond, ...) do { \
+    checks++; \
+    if (!(cond)) { \
+        failures++; \
+        fprintf(stderr, "%s:%d: check failed: %s: ", __FILE__, __LINE__, #cond); \
+        fprintf(stderr, __VA_ARGS__); \
+        fprintf(stderr, "\n"); \
+    } \
+} while (0)
+
+// 与 ttf2bin 的 main 相同的默认头部
+static void initTestFontSet(FontSet *fontSet, int fontSize, int renderMode, int indexMethod) {
+    memset(fontSet, 0, sizeof(FontSet));
+    fontSet->fileFlag = 2;
+    memcpy(fontSet->version, FONTSET_VERSION_BASE, 4);
+    fontSet->fontSize = (char)fontSize;
+    fontSet->renderMode = (char)renderMode;
+    fontSet->indexMethod = indexMethod;
+}
+
+static int generate(const char *ttfPath, const char *binPath, const char *text, int fontSize, int renderMode,
+                    int indexMethod, const GenerateOptions *options) {
+    FontSet fontSet;
+    initTestFontSet(&fontSet, fontSize, renderMode, indexMethod);
+    int result = generateBinFileEx(ttfPath, binPath, text, &fontSet, options);
+    CHECK(result == 0, "generate %s from %s", binPath, ttfPath);
+    return result;
+}
+
+static int sameFileContent(const char *pathA, const char *pathB) {
+    MappedFile a, b;
+    if (mapFileReadOnly(pathA, &a) != 0) return 0;
+    if (mapFileReadOnly(pathB, &b) != 0) {
+        unmapFile(&a);
+        return 0;
+    }
+    int same = a.size == b.size && memcmp(a.data, b.data, a.size) == 0;
+    unmapFile(&a);
+    unmapFile(&b);
+    return same;
+}
+
+// 把 UTF-8 文本转成升序、去重的码位
+static int textCodepoints(const char *text, uint16_t **codepoints) {
+    Charset set;
+    charsetClear(&set);
+    charsetAddUtf8Text(&set, text);
+    return charsetToArray(&set, codepoints);
+}
+
+static int pointCount(const FontGlyphData *glyph) {
+    int count = 0;
+    for (int i = 0; i < glyph->winding_count; ++i) count += glyph->winding_lengths[i];
+    return count;
+}
+
+static void freeGlyph(FontGlyphData *glyph) {
+    free(glyph->winding_lengths);
+    free(glyph->windings);
+}
+
+// 默认参数的输出必须与原始版本逐字节相同（tests/baseline 下的文件由改动之前的 ttf2bin.c 生成），
+// 同时检查不同线程数的结果一致
+static void testBaselineIdentity(void) {
+    static const struct {
+        const char *ttf;
+        const char *text;
+        int fontSize;
+        int renderMode;
+        const char *baseline;
+    } cases[] = {
+        { "STXihei.ttf", NULL, 32, 4, "tests/baseline/STXihei_32_4_twgx_ascii.bin" },
+        { "STXINGKA.TTF", NULL, 32, 2, "tests/baseline/STXINGKA_32_2_twgx_ascii.bin" },
+        { "Quicksand_Regular.ttf", NULL, 32, 4, "tests/baseline/Quicksand_Regular_32_4_twgx_ascii.bin" },
+        { "Quicksand_Medium.ttf", "ascii", 64, 4, "tests/baseline/Quicksand_Medium_64_4_ascii.bin" },
+    };
+    static const int threadCounts[] = { 1, 4, 8 };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        const char *text = cases[i].text ? asciiText : twgxAsciiText;
+        for (size_t t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); ++t) {
+            GenerateOptions options;
+            initGenerateOptions(&options);
+            options.threadCount = threadCounts[t];
+            char binPath[256];
+            snprintf(binPath, sizeof(binPath), OUT_DIR "/baseline_%zu_%d.bin", i, threadCounts[t]);
+            if (generate(cases[i].ttf, binPath, text, cases[i].fontSize, cases[i].renderMode, INDEX_METHOD_SORTED, &options) != 0) continue;
+            CHECK(sameFileContent(binPath, cases[i].baseline), "%s (%d threads) differs from %s", binPath, threadCounts[t], cases[i].baseline);
+        }
+    }
+}
+
+// 三条查找路径（每次解析头部的内存查找、逐项读文件、挂载）对每个码位给出相同的偏移
+static void checkLookupEquivalence(const char *binPath) {
+    int length = 0;
+    uint8_t *mem = loadFileToMemory(binPath, &length);
+    CHECK(mem != NULL, "load %s", binPath);
+    if (!mem) return;
+
+    MountedBin bin;
+    int mounted = mountBin(&bin, mem, (size_t)length, 0) == 0;
+    CHECK(mounted, "mount %s", binPath);
+    int mismatches = 0;
+    for (int unicode = 0; unicode <= 0xFFFF && mounted; ++unicode) {
+        int memoryOffset = getGlyphOffsetFromMemory((uint16_t)unicode, mem);
+        int mountedOffset = mountedBinFindGlyph(&bin, (uint16_t)unicode);
+        // 原来的格式中排在最后的缺字指向文件末尾，只有挂载时知道文件长度，能把它识别为缺字
+        if (mountedOffset == 0 && memoryOffset == length) mountedOffset = memoryOffset;
+        // 逐项读文件较慢，只抽查
+        int fileOffset = unicode % 61 == 0 ? getGlyphOffsetFromBinFile((uint16_t)unicode, binPath) : memoryOffset;
+        if (memoryOffset != mountedOffset || memoryOffset != fileOffset) {
+            if (mismatches++ < 5) {
+                CHECK(0, "%s U+%04X: memory %d, mounted %d, file %d", binPath, unicode, memoryOffset, mountedOffset, fileOffset);
+            }
+        }
+    }
+    CHECK(mismatches == 0, "%s: %d lookup mismatches", binPath, mismatches);
+    if (mounted) unmountBin(&bin);
+    free(mem);
+}
+
+// 每种轮廓编码 × 索引布局 × 查找方式生成后读回：raw 和 delta 与参考文件逐点相同，
+// quantized 在量化步长以内，curves 与 raw 的包围盒相同，edges 有轮廓的字形都有边
+static void testRoundTrip(void) {
+    const char *ttf = "STXihei.ttf";
+    uint16_t *codepoints;
+    int count = textCodepoints(twgxAsciiText, &codepoints);
+    CHECK(count > 0, "charset");
+
+    GenerateOptions rawOptions;
+    initGenerateOptions(&rawOptions);
+    const char *referencePath = OUT_DIR "/roundtrip_reference.bin";
+    if (generate(ttf, referencePath, twgxAsciiText, 32, 4, INDEX_METHOD_SORTED, &rawOptions) != 0) return;
+    int referenceLength = 0;
+    uint8_t *reference = loadFileToMemory(referencePath, &referenceLength);
+    CHECK(reference != NULL, "load reference");
+    if (!reference) return;
+    float scale = getBinScaleForPixelHeight(reference, 32);
+
+    for (int format = OUTLINE_FORMAT_RAW; format <= OUTLINE_FORMAT_EDGES; ++format) {
+        for (int layout = INDEX_LAYOUT_INTERLEAVED; layout <= INDEX_LAYOUT_PAGED; ++layout) {
+            for (int method = INDEX_METHOD_LINEAR; method <= INDEX_METHOD_SORTED; ++method) {
+                GenerateOptions options;
+                initGenerateOptions(&options);
+                options.outlineFormat = format;
+                options.indexLayout = layout;
+                options.quantBits = 8;
+                char binPath[256];
+                snprintf(binPath, sizeof(binPath), OUT_DIR "/roundtrip_%s_%s_%d.bin", outlineFormatNames[format], indexLayoutNames[layout], method);
+                if (generate(ttf, binPath, twgxAsciiText, 32, 4, method, &options) != 0) continue;
+
+                checkLookupEquivalence(binPath);
+
+                int length = 0;
+                uint8_t *mem = loadFileToMemory(binPath, &length);
+                FontSet header;
+                CHECK(mem && parseBinHeader(mem, (size_t)length, &header) > 0, "parse %s", binPath);
+                if (!mem) continue;
+                int baseline = format == OUTLINE_FORMAT_RAW && layout == INDEX_LAYOUT_INTERLEAVED;
+                CHECK(memcmp(header.version, baseline ? FONTSET_VERSION_BASE : FONTSET_VERSION_EXTENDED, 4) == 0,
+                      "%s version %.4s", binPath, header.version);
+                CHECK((header.rsvd & OUTLINE_FORMAT_MASK) == format && header.indexLayout == layout && header.indexMethod == method,
+                      "%s header fields", binPath);
+
+                for (int i = 0; i < count; ++i) {
+                    int referenceOffset = getGlyphOffsetFromMemory(codepoints[i], reference);
+                    int offset = getGlyphOffsetFromHeader(codepoints[i], mem, &header);
+                    CHECK((offset > 0) == (referenceOffset > 0), "%s U+%04X presence", binPath, codepoints[i]);
+                    if (offset <= 0 || referenceOffset <= 0) continue;
+
+                    FontGlyphData expected;
+                    if (readFontGlyphData(reference, referenceOffset, &expected) != 0) {
+                        CHECK(0, "read reference U+%04X", codepoints[i]);
+                        continue;
+                    }
+                    if (format == OUTLINE_FORMAT_EDGES) {
+                        CHECK((getGlyphEdgeCount(mem + offset) > 0) == (pointCount(&expected) > 0),
+                              "%s U+%04X edge count %d", binPath, codepoints[i], getGlyphEdgeCount(mem + offset));
+                        freeGlyph(&expected);
+                        continue;
+                    }
+
+                    FontGlyphData glyph;
+                    if (readFontGlyphDataFromHeader(mem, &header, offset, &glyph) != 0) {
+                        CHECK(0, "%s read U+%04X", binPath, codepoints[i]);
+                        freeGlyph(&expected);
+                        continue;
+                    }
+                    CHECK(glyph.sx0 == expected.sx0 && glyph.sy0 == expected.sy0 && glyph.sx1 == expected.sx1 &&
+                          glyph.sy1 == expected.sy1 && glyph.advance == expected.advance,
+                          "%s U+%04X metrics", binPath, codepoints[i]);
+                    if (format != OUTLINE_FORMAT_CURVES) {
+                        int n = pointCount(&expected);
+                        CHECK(glyph.winding_count == expected.winding_count && pointCount(&glyph) == n &&
+                              memcmp(glyph.winding_lengths, expected.winding_lengths, expected.winding_count) == 0,
+                              "%s U+%04X contours", binPath, codepoints[i]);
+                        if (pointCount(&glyph) == n) {
+                            // 量化误差：每个分量不超过半个量化步长，再加上取整的 1 个单位
+                            int extent = abs(expected.sx1 - expected.sx0) > abs(expected.sy1 - expected.sy0)
+                                       ? abs(expected.sx1 - expected.sx0) : abs(expected.sy1 - expected.sy0);
+                            float bound = format == OUTLINE_FORMAT_QUANTIZED ? extent / (float)((1 << 8) - 1) / 2 + 1 : 0;
+                            float maxError = 0;
+                            for (int k = 0; k < 2 * n; ++k) {
+                                float error = fabsf((float)(glyph.windings[k] - expected.windings[k]));
+                                if (error > maxError) maxError = error;
+                            }
+                            CHECK(maxError <= bound, "%s U+%04X error %.1f > %.1f units", binPath, codepoints[i], maxError, bound);
+                            if (format == OUTLINE_FORMAT_QUANTIZED) {
+                                CHECK(maxError * scale <= 0.1f, "%s U+%04X quantize error %.3f px", binPath, codepoints[i], maxError * scale);
+                            }
+                        }
+                    } else {
+                        CHECK(glyph.winding_count == expected.winding_count, "%s U+%04X curves contours", binPath, codepoints[i]);
+                    }
+                    freeGlyph(&glyph);
+                    freeGlyph(&expected);
+                }
+                free(header.fontName);
+                free(mem);
+            }
+        }
+    }
+    free(reference);
+    free(codepoints);
+}
+
+// 缺字的三种处理方式在各索引布局下查找结果一致；Quicksand 不含汉字
+static void testMissingGlyphs(void) {
+    static const int modes[] = { MISSING_GLYPH_EMPTY, MISSING_GLYPH_OMIT, MISSING_GLYPH_NOTDEF };
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m) {
+        for (int layout = INDEX_LAYOUT_INTERLEAVED; layout <= INDEX_LAYOUT_PAGED; ++layout) {
+            GenerateOptions options;
+            initGenerateOptions(&options);
+            options.missingGlyphs = modes[m];
+            options.indexLayout = layout;
+            char binPath[256];
+            snprintf(binPath, sizeof(binPath), OUT_DIR "/missing_%d_%s.bin", modes[m], indexLayoutNames[layout]);
+            if (generate("Quicksand_Regular.ttf", binPath, twgxAsciiText, 32, 4, INDEX_METHOD_SORTED, &options) != 0) continue;
+            checkLookupEquivalence(binPath);
+
+            int length = 0;
+            uint8_t *mem = loadFileToMemory(binPath, &length);
+            if (!mem) continue;
+            // 原来的格式（empty）中缺字与下一条记录共用偏移，查找时无法区分
+            if (modes[m] != MISSING_GLYPH_EMPTY) {
+                CHECK(getGlyphOffsetFromMemory(0x738B, mem) == 0, "%s: missing U+738B found", binPath);  // 王
+            }
+            CHECK(getGlyphOffsetFromMemory('A', mem) > 0, "%s: U+0041 not found", binPath);
+            free(mem);
+        }
+    }
+}
+
+// 多线程提取、去重和各编码格式的输出与单线程相同
+static void testThreadDeterminism(void) {
+    static const int formats[] = { OUTLINE_FORMAT_RAW, OUTLINE_FORMAT_DELTA, OUTLINE_FORMAT_CURVES, OUTLINE_FORMAT_QUANTIZED, OUTLINE_FORMAT_EDGES };
+    for (size_t f = 0; f < sizeof(formats) / sizeof(formats[0]); ++f) {
+        char singlePath[256];
+        snprintf(singlePath, sizeof(singlePath), OUT_DIR "/threads_%s_1.bin", outlineFormatNames[formats[f]]);
+        GenerateOptions options;
+        initGenerateOptions(&options);
+        options.outlineFormat = formats[f];
+        options.simplifyTolerance = formats[f] == OUTLINE_FORMAT_DELTA ? 0.25f : 0;
+        options.threadCount = 1;
+        if (generate("STXINGKA.TTF", singlePath, twgxAsciiText, 32, 4, INDEX_METHOD_SORTED, &options) != 0) continue;
+
+        options.threadCount = 8;
+        char multiPath[256];
+        snprintf(multiPath, sizeof(multiPath), OUT_DIR "/threads_%s_8.bin", outlineFormatNames[formats[f]]);
+        if (generate("STXINGKA.TTF", multiPath, twgxAsciiText, 32, 4, INDEX_METHOD_SORTED, &options) != 0) continue;
+        CHECK(sameFileContent(singlePath, multiPath), "%s differs from %s", multiPath, singlePath);
+    }
+}
+
+static float testPointSegmentDistance(float px, float py, float ax, float ay, float bx, float by) {
+    float dx = bx - ax, dy = by - ay;
+    float lengthSquared = dx * dx + dy * dy;
+    float t = lengthSquared > 0 ? ((px - ax) * dx + (py - ay) * dy) / lengthSquared : 0;
+    t = t < 0 ? 0 : t > 1 ? 1 : t;
+    float ex = ax + t * dx - px, ey = ay + t * dy - py;
+    return sqrtf(ex * ex + ey * ey);
+}
+
+// 简化后的轮廓与原轮廓的距离不超过容差；定点像素坐标与字体单位坐标换算后相差不超过半个单位
+static void testSimplifyAndFixedPoint(void) {
+    const float tolerance = 0.25f;
+    const int fixedPointBits = 2;
+    uint16_t *codepoints;
+    int count = textCodepoints(twgxAsciiText, &codepoints);
+
+    GenerateOptions options;
+    initGenerateOptions(&options);
+    const char *rawPath = OUT_DIR "/bounds_raw.bin";
+    const char *simplePath = OUT_DIR "/bounds_simplify.bin";
+    const char *fixedPath = OUT_DIR "/bounds_fixed.bin";
+    generate("STXINGKA.TTF", rawPath, twgxAsciiText, 32, 4, INDEX_METHOD_SORTED, &options);
+    options.simplifyTolerance = tolerance;
+    generate("STXINGKA.TTF", simplePath, twgxAsciiText, 32, 4, INDEX_METHOD_SORTED, &options);
+    options.simplifyTolerance = 0;
+    options.fixedPointBits = fixedPointBits;
+    generate("STXINGKA.TTF", fixedPath, twgxAsciiText, 32, 4, INDEX_METHOD_SORTED, &options);
+
+    int length = 0;
+    uint8_t *raw = loadFileToMemory(rawPath, &length);
+    uint8_t *simple = loadFileToMemory(simplePath, &length);
+    uint8_t *fixed = loadFileToMemory(fixedPath, &length);
+    CHECK(raw && simple && fixed, "load bounds files");
+    if (!raw || !simple || !fixed) return;
+    float scale = getBinScaleForPixelHeight(raw, 32);
+    FontSet fixedHeader;
+    CHECK(parseBinHeader(fixed, (size_t)length, &fixedHeader) > 0 && fixedHeader.fixedPointBits == fixedPointBits,
+          "fixed-point header");
+    float pixelScale = fixedHeader.fontScale * (float)(1 << fixedPointBits);
+    free(fixedHeader.fontName);
+
+    long rawPoints = 0, simplePoints = 0;
+    for (int i = 0; i < count; ++i) {
+        int rawOffset = getGlyphOffsetFromMemory(codepoints[i], raw);
+        int simpleOffset = getGlyphOffsetFromMemory(codepoints[i], simple);
+        int fixedOffset = getGlyphOffsetFromMemory(codepoints[i], fixed);
+        if (rawOffset <= 0 || simpleOffset <= 0 || fixedOffset <= 0) continue;
+        FontGlyphData a, b, c;
+        if (readFontGlyphData(raw, rawOffset, &a) != 0) continue;
+        if (readFontGlyphData(simple, simpleOffset, &b) != 0) {
+            freeGlyph(&a);
+            continue;
+        }
+        if (readFontGlyphData(fixed, fixedOffset, &c) != 0) {
+            freeGlyph(&a);
+            freeGlyph(&b);
+            continue;
+        }
+
+        // 简化：逐个轮廓求原轮廓每个点到简化后折线的距离，允许 short 取整带来的 1 个单位
+        CHECK(a.winding_count == b.winding_count, "U+%04X simplify contours", codepoints[i]);
+        float maxDistance = 0;
+        const short *pa = a.windings, *pb = b.windings;
+        for (int w = 0; w < a.winding_count && a.winding_count == b.winding_count; ++w) {
+            int na = a.winding_lengths[w], nb = b.winding_lengths[w];
+            for (int k = 0; k < na && nb > 0; ++k) {
+                float best = 1e30f;
+                for (int j = 0; j < nb; ++j) {
+                    int next = (j + 1) % nb;
+                    float d = testPointSegmentDistance(pa[2 * k], pa[2 * k + 1], pb[2 * j], pb[2 * j + 1], pb[2 * next], pb[2 * next + 1]);
+                    if (d < best) best = d;
+                }
+                if (best > maxDistance) maxDistance = best;
+            }
+            pa += 2 * na;
+            pb += 2 * nb;
+        }
+        CHECK(maxDistance <= tolerance / scale + 1.5f, "U+%04X simplify distance %.2f px > %.2f px",
+              codepoints[i], maxDistance * scale, tolerance);
+        rawPoints += pointCount(&a);
+        simplePoints += pointCount(&b);
+
+        // 定点像素：点数不变，坐标等于字体单位乘以缩放比例；定点坐标四舍五入（半个单位），
+        // 原始格式的 short 坐标是截断的（最多 1 个字体单位）
+        CHECK(pointCount(&c) == pointCount(&a), "U+%04X fixed-point point count", codepoints[i]);
+        if (pointCount(&c) == pointCount(&a)) {
+            float maxError = 0;
+            for (int k = 0; k < 2 * pointCount(&a); ++k) {
+                float error = fabsf((float)c.windings[k] - (float)a.windings[k] * pixelScale);
+                if (error > maxError) maxError = error;
+            }
+            CHECK(maxError <= 0.5f + pixelScale + 1e-3f, "U+%04X fixed-point error %.3f", codepoints[i], maxError);
+        }
+        freeGlyph(&a);
+        freeGlyph(&b);
+        freeGlyph(&c);
+    }
+    CHECK(simplePoints < rawPoints, "simplify removed no points (%ld vs %ld)", simplePoints, rawPoints);
+    free(raw);
+    free(simple);
+    free(fixed);
+    free(codepoints);
+}
+
+// 增量更新：内容哈希一致时复用记录，结果与全量生成相同；字体不同或容差变化时不复用
+static void testIncrementalUpdate(void) {
+    LoadedFont font;
+    CHECK(loadFontFile(&font, "STXihei.ttf") == 0, "load STXihei.ttf");
+    uint16_t *small, *large;
+    int smallCount = textCodepoints(asciiText, &small);
+    int largeCount = textCodepoints(twgxAsciiText, &large);
+
+    GenerateOptions options;
+    initGenerateOptions(&options);
+    options.fontHash = font.hash;
+    options.glyphLookup = &font.lookup;
+    options.recordFontHash = 1;
+    options.outlineFormat = OUTLINE_FORMAT_DELTA;
+
+    FontSet fontSet;
+    initTestFontSet(&fontSet, 32, 4, INDEX_METHOD_SORTED);
+    const char *smallPath = OUT_DIR "/update_small.bin";
+    const char *fullPath = OUT_DIR "/update_full.bin";
+    const char *updatedPath = OUT_DIR "/update_updated.bin";
+    CHECK(generateBinFileFromCodepoints(&font.info, smallPath, small, smallCount, &fontSet, &options) == 0, "generate small");
+    initTestFontSet(&fontSet, 32, 4, INDEX_METHOD_SORTED);
+    CHECK(generateBinFileFromCodepoints(&font.info, fullPath, large, largeCount, &fontSet, &options) == 0, "generate full");
+
+    // 未指定参数（fontSet 为空）时沿用旧文件的头部
+    CHECK(updateBinFileFromCodepoints(&font.info, smallPath, updatedPath, large, largeCount, NULL, &options) == 0, "update");
+    CHECK(sameFileContent(updatedPath, fullPath), "incremental update differs from full generation");
+
+    // 批量模式：内容哈希不同或容差变化时要求全量生成
+    GenerateOptions changed = options;
+    changed.fontHash = font.hash ^ 1;
+    initTestFontSet(&fontSet, 32, 4, INDEX_METHOD_SORTED);
+    CHECK(updateBinFileFromCodepoints(&font.info, smallPath, updatedPath, large, largeCount, &fontSet, &changed) == 1,
+          "update accepted a different font hash");
+    changed = options;
+    changed.simplifyTolerance = 0.25f;
+    initTestFontSet(&fontSet, 32, 4, INDEX_METHOD_SORTED);
+    CHECK(updateBinFileFromCodepoints(&font.info, smallPath, updatedPath, large, largeCount, &fontSet, &changed) == 1,
+          "update accepted a different simplify tolerance");
+
+    free(small);
+    free(large);
+    freeLoadedFont(&font);
+}
+
+// 字形缓存：命中的输出与不用缓存时相同；记录长度损坏或哈希不符的缓存文件按未命中处理
+static void testGlyphCache(void) {
+    const char *directory = OUT_DIR "/cache";
+    const char *plainPath = OUT_DIR "/cache_plain.bin";
+    const char *cachedPath = OUT_DIR "/cache_cached.bin";
+    GenerateOptions options;
+    initGenerateOptions(&options);
+    options.outlineFormat = OUTLINE_FORMAT_DELTA;
+    generate("STXihei.ttf", plainPath, twgxAsciiText, 32, 4, INDEX_METHOD_SORTED, &options);
+
+    GlyphCache cache;
+    CHECK(glyphCacheOpen(&cache, directory, 0) == 0, "open cache");
+    options.glyphCache = &cache;
+    generate("STXihei.ttf", cachedPath, twgxAsciiText, 32, 4, INDEX_METHOD_SORTED, &options);  // 填充缓存
+
+    // 破坏缓存中 “王” 和 “A” 的记录长度（超长和比记录头还短）：按文件名找到它们
+    LoadedFont font;
+    CHECK(loadFontFile(&font, "STXihei.ttf") == 0, "load STXihei.ttf");
+    GlyphParams params;
+    params.flatness = 1.0f / stbtt_ScaleForPixelHeight(&font.info, 32) / 4;
+    params.outlineFormat = OUTLINE_FORMAT_DELTA;
+    params.simplify = 0;
+    params.quantBits = options.quantBits;
+    params.pixelScale = 0;
+    static const struct {
+        int unicode;
+        uint32_t length;
+    } corruptions[] = { { 0x738B, 0xFFFFFFF0u }, { 'A', 0 } };
+    for (size_t i = 0; i < sizeof(corruptions) / sizeof(corruptions[0]); ++i) {
+        char path[1024];
+        glyphCachePath(&cache, font.hash, stbtt_FindGlyphIndex(&font.info, corruptions[i].unicode), glyphParamsHash(&params), path, sizeof(path));
+        FILE *file = fopen(path, "r+b");
+        CHECK(file != NULL, "cache file %s", path);
+        if (file) {
+            fseek(file, sizeof(uint32_t), SEEK_SET);
+            fwrite(&corruptions[i].length, sizeof(uint32_t), 1, file);
+            fclose(file);
+        }
+    }
+    freeLoadedFont(&font);
+
+    long hits = cache.hits, misses = cache.misses;
+    generate("STXihei.ttf", cachedPath, twgxAsciiText, 32, 4, INDEX_METHOD_SORTED, &options);
+    CHECK(cache.misses - misses == 2 && cache.hits > hits, "cache hits %ld misses %ld", cache.hits - hits, cache.misses - misses);
+    CHECK(sameFileContent(plainPath, cachedPath), "cached output differs");
+    glyphCacheClose(&cache);
+}
+
+// 校验和：带校验和的文件可以校验后挂载；截断、改动任意一个字节都会被拒绝；要求校验和时拒绝不带校验和的文件
+static void testChecksumMount(void) {
+    const char *checkedPath = OUT_DIR "/checksum_on.bin";
+    const char *plainPath = OUT_DIR "/checksum_off.bin";
+    GenerateOptions options;
+    initGenerateOptions(&options);
+    generate("STXihei.ttf", plainPath, twgxAsciiText, 32, 4, INDEX_METHOD_SORTED, &options);
+    options.checksum = 1;
+    generate("STXihei.ttf", checkedPath, twgxAsciiText, 32, 4, INDEX_METHOD_SORTED, &options);
+
+    int length = 0, plainLength = 0;
+    uint8_t *data = loadFileToMemory(checkedPath, &length);
+    uint8_t *plain = loadFileToMemory(plainPath, &plainLength);
+    CHECK(data && plain, "load checksum files");
+    if (!data || !plain) return;
+
+    MountedBin bin;
+    CHECK(verifyBinChecksum(data, (size_t)length) == 1, "checksum does not verify");
+    int mounted = mountBin(&bin, data, (size_t)length, MOUNT_VERIFY_CHECKSUM | MOUNT_REQUIRE_CHECKSUM) == 0;
+    CHECK(mounted, "checksummed bin does not mount");
+    if (mounted) {
+        CHECK(bin.hasChecksum && mountedBinFindGlyph(&bin, 'A') > 0, "lookup in checksummed bin");
+        unmountBin(&bin);
+    }
+
+    CHECK(mountBin(&bin, data, (size_t)length - 1, MOUNT_VERIFY_CHECKSUM) != 0, "truncated bin mounted");
+    CHECK(mountBin(&bin, data, (size_t)length / 2, MOUNT_VERIFY_CHECKSUM) != 0, "half bin mounted");
+
+    // 头部、索引区、字形区各改动一个字节
+    const int positions[] = { 4, plain[0] + 2, length / 2, length - 9 };
+    for (size_t i = 0; i < sizeof(positions) / sizeof(positions[0]); ++i) {
+        data[positions[i]] ^= 0x01;
+        CHECK(mountBin(&bin, data, (size_t)length, MOUNT_VERIFY_CHECKSUM) != 0, "bin with byte %d flipped mounted", positions[i]);
+        data[positions[i]] ^= 0x01;
+    }
+
+    CHECK(verifyBinChecksum(plain, (size_t)plainLength) == 0, "plain bin reports a checksum");
+    CHECK(mountBin(&bin, plain, (size_t)plainLength, MOUNT_REQUIRE_CHECKSUM) != 0, "bin without checksum mounted under MOUNT_REQUIRE_CHECKSUM");
+    mounted = mountBin(&bin, plain, (size_t)plainLength, MOUNT_VERIFY_CHECKSUM) == 0;
+    CHECK(mounted, "bin without checksum refused under MOUNT_VERIFY_CHECKSUM");
+    if (mounted) unmountBin(&bin);
+
+    free(data);
+    free(plain);
+}
+
+// 内置字符集的字数（GB2312 一级 3755、二级 3008、1–9 区符号 682，Big5 常用字 5401）、集合运算和字符集表达式
+static void testCharsets(void) {
+    static const struct {
+        const char *name;
+        int count;
+    } presets[] = {
+        { "ascii", 94 },
+        { "gb2312-1", 3755 },
+        { "gb2312-2", 3008 },
+        { "gb2312", 3755 + 3008 + 682 },
+        { "big5-common", 5401 },
+    };
+    Charset set, other;
+    for (size_t i = 0; i < sizeof(presets) / sizeof(presets[0]); ++i) {
+        charsetClear(&set);
+        CHECK(charsetAddPreset(&set, presets[i].name) == 0, "preset %s", presets[i].name);
+        CHECK(charsetCount(&set) == presets[i].count, "preset %s has %d characters, expected %d",
+              presets[i].name, charsetCount(&set), presets[i].count);
+    }
+    charsetClear(&set);
+    CHECK(charsetAddPreset(&set, "gb2312-3") == -1 && charsetCount(&set) == 0, "unknown preset accepted");
+
+    // 一级、二级汉字互不相交；“王”是一级字
+    charsetClear(&set);
+    charsetClear(&other);
+    charsetAddPreset(&set, "gb2312-1");
+    charsetAddPreset(&other, "gb2312-2");
+    charsetIntersect(&set, &other);
+    CHECK(charsetCount(&set) == 0, "gb2312 levels overlap by %d", charsetCount(&set));
+    charsetClear(&set);
+    charsetAddPreset(&set, "gb2312-1");
+    CHECK(charsetContains(&set, 0x738B) && !charsetContains(&other, 0x738B), "U+738B level");
+
+    charsetClear(&set);
+    charsetClear(&other);
+    charsetAddRange(&set, 0x20, 0x7F);
+    charsetAddPreset(&other, "ascii");
+    charsetIntersect(&set, &other);
+    CHECK(charsetCount(&set) == 94 && !charsetContains(&set, 0x20) && !charsetContains(&set, 0x7F), "range & ascii");
+    charsetClear(&other);
+    charsetAddRange(&other, 'A', 'Z');
+    charsetSubtract(&set, &other);
+    CHECK(charsetCount(&set) == 94 - 26 && !charsetContains(&set, 'A') && charsetContains(&set, 'a'), "ascii - A..Z");
+    charsetClear(&set);
+    charsetAddRange(&set, 0xFFFE, 0xFFFF);
+    CHECK(charsetCount(&set) == 2, "range at the end of the BMP");
+
+    // 表达式从左到右计算；GB2312 的符号都是全角，与 ASCII 不相交
+    CHECK(evaluateCharsetSpec("gb2312 - ascii", NULL, &set) == 0 && charsetCount(&set) == 7445, "gb2312 - ascii: %d", charsetCount(&set));
+    CHECK(evaluateCharsetSpec("gb2312-1 + gb2312-2 & big5-common", NULL, &set) == 0, "expression");
+    charsetClear(&other);
+    charsetAddPreset(&other, "gb2312-1");
+    charsetAddPreset(&other, "gb2312-2");
+    Charset big5;
+    charsetClear(&big5);
+    charsetAddPreset(&big5, "big5-common");
+    charsetIntersect(&other, &big5);
+    CHECK(memcmp(&set, &other, sizeof(Charset)) == 0, "gb2312-1 + gb2312-2 & big5-common");
+
+    // font: 操作数：Quicksand 覆盖全部 ASCII、没有汉字
+    CHECK(evaluateCharsetSpec("gb2312 + ascii - font:Quicksand_Regular.ttf", NULL, &set) == 0, "font expression");
+    LoadedFont font;
+    if (loadFontFile(&font, "Quicksand_Regular.ttf") == 0) {
+        charsetClear(&other);
+        charsetAddPreset(&other, "gb2312");
+        charsetAddPreset(&other, "ascii");
+        Charset coverage;
+        charsetClear(&coverage);
+        charsetAddFontCoverage(&coverage, &font.info);
+        charsetSubtract(&other, &coverage);
+        CHECK(memcmp(&set, &other, sizeof(Charset)) == 0, "font: operand");
+        CHECK(!charsetContains(&set, 'A') && charsetContains(&set, 0x738B), "font: operand removes ASCII only");
+        freeLoadedFont(&font);
+    }
+    CHECK(evaluateCharsetSpec("ascii +", NULL, &set) != 0, "dangling operator accepted");
+    CHECK(evaluateCharsetSpec("ascii + no-such-charset", NULL, &set) != 0, "unknown operand accepted");
+}
+
+// 流式 UTF-8 解码：多字节字符跨分块边界、过长编码、被截断的序列和输入末尾未完成的序列
+static void testUtf8Chunks(void) {
+    Utf8Decoder decoder;
+    Charset set;
+
+    // “王”（E7 8E 8B）在每个位置拆成两块，结果与整块解码相同
+    const uint8_t wang[] = { 0xE7, 0x8E, 0x8B };
+    for (size_t split = 1; split < sizeof(wang); ++split) {
+        charsetClear(&set);
+        utf8DecoderInit(&decoder);
+        utf8DecodeChunk(&decoder, wang, split, &set);
+        CHECK(charsetCount(&set) == 0, "partial sequence emitted at split %zu", split);
+        utf8DecodeChunk(&decoder, wang + split, sizeof(wang) - split, &set);
+        utf8DecoderFinish(&decoder);
+        CHECK(charsetCount(&set) == 1 && charsetContains(&set, 0x738B) && decoder.invalidCount == 0,
+              "split %zu: %d characters, %ld invalid", split, charsetCount(&set), decoder.invalidCount);
+    }
+
+    // 4 字节字符逐字节输入：BMP 以外，计数但不加入字符集
+    const uint8_t emoji[] = { 0xF0, 0x9F, 0x98, 0x80 };
+    charsetClear(&set);
+    utf8DecoderInit(&decoder);
+    for (size_t i = 0; i < sizeof(emoji); ++i) utf8DecodeChunk(&decoder, emoji + i, 1, &set);
+    utf8DecoderFinish(&decoder);
+    CHECK(charsetCount(&set) == 0 && decoder.supplementaryCount == 1 && decoder.invalidCount == 0, "U+1F600 byte by byte");
+
+    // 过长编码：C0 AF 和 E0 80 AF 都是 '/' 的非法写法，不能加入 '/'
+    const uint8_t overlong[] = { 0xC0, 0xAF, 'a', 0xE0, 0x80, 0xAF, 'b' };
+    charsetClear(&set);
+    utf8DecoderInit(&decoder);
+    utf8DecodeChunk(&decoder, overlong, 4, &set);
+    utf8DecodeChunk(&decoder, overlong + 4, sizeof(overlong) - 4, &set);
+    utf8DecoderFinish(&decoder);
+    CHECK(charsetCount(&set) == 2 && charsetContains(&set, 'a') && charsetContains(&set, 'b') && !charsetContains(&set, '/') &&
+          decoder.invalidCount == 2, "overlong: %d characters, %ld invalid", charsetCount(&set), decoder.invalidCount);
+
+    // 中途被截断的序列和孤立的后续字节各计一次，之后的 ASCII 字符照常加入
+    const uint8_t truncated[] = { 0xE7, 0x8E, 'A', 0x8B, 'B' };
+    charsetClear(&set);
+    utf8DecoderInit(&decoder);
+    utf8DecodeChunk(&decoder, truncated, 2, &set);
+    utf8DecodeChunk(&decoder, truncated + 2, sizeof(truncated) - 2, &set);
+    utf8DecoderFinish(&decoder);
+    CHECK(charsetCount(&set) == 2 && charsetContains(&set, 'A') && charsetContains(&set, 'B') && decoder.invalidCount == 2,
+          "truncated: %d characters, %ld invalid", charsetCount(&set), decoder.invalidCount);
+
+    // 输入末尾未完成的序列只在 utf8DecoderFinish 时计数
+    const uint8_t tail[] = { 'x', 0xE7, 0x8E };
+    charsetClear(&set);
+    utf8DecoderInit(&decoder);
+    utf8DecodeChunk(&decoder, tail, sizeof(tail), &set);
+    CHECK(decoder.invalidCount == 0, "tail counted before finish");
+    utf8DecoderFinish(&decoder);
+    CHECK(charsetCount(&set) == 1 && charsetContains(&set, 'x') && decoder.invalidCount == 1,
+          "tail: %d characters, %ld invalid", charsetCount(&set), decoder.invalidCount);
+
+    // 整段文本在任意位置分块，结果都与一次性解码相同
+    Charset whole;
+    charsetClear(&whole);
+    charsetAddUtf8Text(&whole, twgxAsciiText);
+    size_t length = strlen(twgxAsciiText);
+    for (size_t split = 1; split < length; split += 7) {
+        charsetClear(&set);
+        utf8DecoderInit(&decoder);
+        utf8DecodeChunk(&decoder, (const uint8_t *)twgxAsciiText, split, &set);
+        utf8DecodeChunk(&decoder, (const uint8_t *)twgxAsciiText + split, length - split, &set);
+        utf8DecoderFinish(&decoder);
+        CHECK(memcmp(&set, &whole, sizeof(Charset)) == 0 && decoder.invalidCount == 0, "text split at %zu", split);
+    }
+}
+
+int main(void) {
+#ifdef _WIN32
+    CreateDirectoryA(OUT_DIR, NULL);
+#else
+    mkdir(OUT_DIR, 0755);
+#endif
+    testBaselineIdentity();
+    testRoundTrip();
+    testMissingGlyphs();
+    testThreadDeterminism();
+    testSimplifyAndFixedPoint();
+    testIncrementalUpdate();
+    testGlyphCache();
+    testChecksumMount();
+    testCharsets();
+    testUtf8Chunks();
+
+    printf("%d checks, %d failures\n", checks, failures);
+    return failures ? 1 : 0;
+}
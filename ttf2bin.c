@@ -1,752 +1,5435 @@
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <stdint.h>
-
-#define STB_TRUETYPE_IMPLEMENTATION
-#include "stb_truetype.h"
-
-
-// 定义 FontSet 结构体
-typedef struct {
-    char length;
-    char fileFlag;
-    char version[4];
-    char fontSize;
-    char renderMode;
-    unsigned char bold : 1;
-    unsigned char italic : 1;
-    unsigned char scanMode : 1;
-    unsigned char indexMethod : 1;
-    unsigned char rsvd : 4;
-    int indexAreaSize;
-    uint8_t fontNameLength;
-    short ascent;
-    short descent;
-    short lineGap;
-    char *fontName;
-} FontSet;
-
-typedef struct {
-    uint16_t unicode;
-    uint32_t offset;
-} GlyphEntry;
-
-// 定义 FontGlyphData 结构体用于保存字形数据信息
-typedef struct {
-    short sx0;
-    short sy0;
-    short sx1;
-    short sy1;
-    short advance;
-    uint8_t winding_count;
-    uint8_t *winding_lengths;
-    short *windings;
-} FontGlyphData;
-
-
-// 函数声明
-char calculateFontSetLength(FontSet *fontSet);
-uint16_t* utf8_to_utf16(const char* utf8_str, int* length);
-int generateBinFile(const char *ttfPath, const char *binPath, const char *text, FontSet *fontSet);
-
-char calculateFontSetLength(FontSet *fontSet) {
-    return 1  // length
-         + 1  // fileFlag
-         + 4  // version
-         + 1  // fontSize
-         + 1  // renderMode
-         + 1  // flags (bold, italic, scanMode, indexMethod, rsvd)
-         + 4  // indexAreaSize
-         + 1  // fontNameLength
-         + 2  // ascent
-         + 2  // descent
-         + 2  // lineGap
-         + fontSet->fontNameLength; // fontName length
-}
-
-uint16_t* utf8_to_utf16(const char* utf8_str, int* length) {
-    int utf16_len = 0;
-    const char *ptr = utf8_str;
-    uint16_t *utf16_str;
-
-    while (*ptr) {
-        unsigned char c = (unsigned char)*ptr;
-        if (c < 0x80) {
-            utf16_len++;
-            ptr++;
-        } else if (c < 0xE0) {
-            utf16_len++;
-            ptr += 2;
-        } else if (c < 0xF0) {
-            utf16_len++;
-            ptr += 3;
-        } else {
-            utf16_len++;
-            ptr += 4;
-        }
-    }
-
-    utf16_str = (uint16_t*)malloc((utf16_len + 1) * sizeof(uint16_t));
-    if (!utf16_str) {
-        *length = 0;
-        return NULL;
-    }
-
-    ptr = utf8_str;
-    uint16_t *out = utf16_str;
-    while (*ptr) {
-        unsigned char c = (unsigned char)*ptr;
-        if (c < 0x80) {
-            *out++ = c;
-            ptr++;
-        } else if (c < 0xE0) {
-            *out++ = ((c & 0x1F) << 6) | (ptr[1] & 0x3F);
-            ptr += 2;
-        } else if (c < 0xF0) {
-            *out++ = ((c & 0x0F) << 12) | ((ptr[1] & 0x3F) << 6) | (ptr[2] & 0x3F);
-            ptr += 3;
-        } else {
-            *out++ = ((c & 0x07) << 18) | ((ptr[1] & 0x3F) << 12) | ((ptr[2] & 0x3F) << 6) | (ptr[3] & 0x3F);
-            ptr += 4;
-        }
-    }
-    *out = 0;
-
-    *length = utf16_len;
-    return utf16_str;
-}
-
-int compare_u16(const void *a, const void *b) {
-    return *(uint16_t *)a - *(uint16_t *)b;
-}
-
-int unique_u16(uint16_t *arr, int length) {
-    if (length == 0) return 0;
-
-    qsort(arr, length, sizeof(uint16_t), compare_u16);
-
-    int new_length = 1;
-    for (int i = 1; i < length; ++i) {
-        if (arr[i] != arr[i - 1]) {
-            arr[new_length++] = arr[i];
-        }
-    }
-    return new_length;
-}
-
-typedef struct {
-    uint16_t unicode;
-    uint32_t offset;
-    uint32_t length; // 增加一个长度字段以存储绘制字形的信息长度
-    void *glyphData; // 直接保存对应的字形信息（包括轮廓和线段信息）
-} GlyphData;
-
-int generateBinFile(const char *ttfPath, const char *binPath, const char *text, FontSet *fontSet) {
-    FILE *ttfFile = fopen(ttfPath, "rb");
-    if (!ttfFile) {
-        fprintf(stderr, "Error opening TTF file!\n");
-        return -1;
-    }
-
-    fseek(ttfFile, 0, SEEK_END);
-    long size = ftell(ttfFile);
-    fseek(ttfFile, 0, SEEK_SET);
-    unsigned char *ttfBuffer = (unsigned char *)malloc(size);
-    if (!ttfBuffer) {
-        fprintf(stderr, "Memory allocation error!\n");
-        fclose(ttfFile);
-        return -1;
-    }
-
-    fread(ttfBuffer, 1, size, ttfFile);
-    fclose(ttfFile);
-
-    stbtt_fontinfo font;
-    if (!stbtt_InitFont(&font, ttfBuffer, stbtt_GetFontOffsetForIndex(ttfBuffer, 0))) {
-        fprintf(stderr, "Failed to initialize font!\n");
-        free(ttfBuffer);
-        return -1;
-    }
-
-    FILE *binFile = fopen(binPath, "wb");
-    if (!binFile) {
-        fprintf(stderr, "Error creating BIN file!\n");
-        free(ttfBuffer);
-        return -1;
-    }
-
-    int utf16_len;
-    uint16_t* utf16_text = utf8_to_utf16(text, &utf16_len);
-    if (!utf16_text) {
-        fprintf(stderr, "UTF-16 conversion error!\n");
-        free(ttfBuffer);
-        fclose(binFile);
-        return -1;
-    }
-
-    int unique_len = unique_u16(utf16_text, utf16_len);
-    fontSet->indexAreaSize = unique_len * (2 + 4);
-
-    int nameStringLength;
-    const char* nameString = stbtt_GetFontNameString(&font, &nameStringLength, 1, 0, 0, 1);
-
-    // 检查 nameString 及 nameStringLength。如果无效，则使用默认字体名 "font"
-    if (nameString == NULL || nameStringLength <= 0) {
-        nameString = "font";
-        nameStringLength = strlen(nameString);
-    }
-
-    fontSet->fontName = (char *)malloc(nameStringLength + 1);
-    if (!fontSet->fontName) {
-        fprintf(stderr, "Memory allocation error for font name!\n");
-        free(ttfBuffer);
-        free(utf16_text);
-        fclose(binFile);
-        return -1;
-    }
-
-    strncpy(fontSet->fontName, nameString, nameStringLength);
-    fontSet->fontName[nameStringLength] = '\0';
-    fontSet->fontNameLength = (uint8_t)nameStringLength;
-
-    int ascent, descent, lineGap;
-    stbtt_GetFontVMetrics(&font, &ascent, &descent, &lineGap);
-    fontSet->ascent = (short)ascent;
-    fontSet->descent = (short)descent;
-    fontSet->lineGap = (short)lineGap;
-
-    fontSet->length = calculateFontSetLength(fontSet);
-
-    fwrite(&fontSet->length, sizeof(char), 1, binFile);
-    fwrite(&fontSet->fileFlag, sizeof(char), 1, binFile);
-    fwrite(fontSet->version, sizeof(char), 4, binFile);
-    fwrite(&fontSet->fontSize, sizeof(char), 1, binFile);
-    fwrite(&fontSet->renderMode, sizeof(char), 1, binFile);
-
-    unsigned char flagByte = (fontSet->bold << 7) |
-                             (fontSet->italic << 6) |
-                             (fontSet->scanMode << 5) |
-                             (fontSet->indexMethod << 4);
-    fwrite(&flagByte, sizeof(char), 1, binFile);
-
-    fwrite(&fontSet->indexAreaSize, sizeof(int), 1, binFile);
-    fwrite(&fontSet->fontNameLength, sizeof(uint8_t), 1, binFile);
-    fwrite(&fontSet->ascent, sizeof(short), 1, binFile);
-    fwrite(&fontSet->descent, sizeof(short), 1, binFile);
-    fwrite(&fontSet->lineGap, sizeof(short), 1, binFile);
-    fwrite(fontSet->fontName, sizeof(char), fontSet->fontNameLength, binFile);
-
-    int *glyphOffsets = (int *)malloc(unique_len * sizeof(int));
-    memset(glyphOffsets, 0, unique_len * sizeof(int));
-
-    int indexStartOffset = ftell(binFile);
-
-    for (int i = 0; i < unique_len; ++i) {
-        uint16_t unicode = utf16_text[i];
-        fwrite(&unicode, sizeof(uint16_t), 1, binFile);
-        glyphOffsets[i] = ftell(binFile);
-        int placeholder = 0;
-        fwrite(&placeholder, sizeof(int), 1, binFile); // 地址占位符
-    }
-
-    int glyphDataOffset = ftell(binFile);
-    float scale = stbtt_ScaleForPixelHeight(&font, fontSet->fontSize);
-
-    // 存储每个字形数据实际偏移地址的数组
-    int *glyphDataStartOffsets = (int *)malloc(unique_len * sizeof(int));
-
-    for (int i = 0; i < unique_len; ++i) {
-        // 记录当前字形数据的偏移地址
-        glyphDataStartOffsets[i] = ftell(binFile);
-
-        int glyphIndex = stbtt_FindGlyphIndex(&font, utf16_text[i]);
-        if (glyphIndex == 0) {
-            continue;
-        }
-
-        int x0, y0, x1, y1;
-        stbtt_GetGlyphBitmapBox(&font, glyphIndex, 1.0, 1.0, &x0, &y0, &x1, &y1);
-
-        short sx0 = (short)x0;
-        short sy0 = (short)y0;
-        short sx1 = (short)x1;
-        short sy1 = (short)y1;
-
-        fwrite(&sx0, sizeof(short), 1, binFile);
-        fwrite(&sy0, sizeof(short), 1, binFile);
-        fwrite(&sx1, sizeof(short), 1, binFile);
-        fwrite(&sy1, sizeof(short), 1, binFile);
-
-        int advance, lsb;
-        stbtt_GetGlyphHMetrics(&font, glyphIndex, &advance, &lsb);
-
-        short sadvancd = (short)advance;
-        fwrite(&sadvancd, sizeof(short), 1, binFile);
-
-        stbtt_vertex *stbVertex = NULL;
-        int verCount = stbtt_GetGlyphShape(&font, glyphIndex, &stbVertex);
-        int winding_count = 0;
-        int *winding_lengths = NULL;
-        stbtt__point *windings = stbtt_FlattenCurves(stbVertex, verCount, 1.0f / scale / fontSet->renderMode, &winding_lengths, &winding_count, NULL);
-
-        uint8_t winding_count_u8 = (uint8_t)winding_count;
-        fwrite(&winding_count_u8, sizeof(uint8_t), 1, binFile);
-
-        for (int j = 0; j < winding_count; ++j) {
-            uint8_t winding_length_u8 = (uint8_t)winding_lengths[j];
-            fwrite(&winding_length_u8, sizeof(uint8_t), 1, binFile);
-        }
-
-        int index = 0;
-        for (int j = 0; j < winding_count; ++j) {
-            for (int k = 0; k < winding_lengths[j]; ++k) {
-                short wx = (short)windings[index].x;
-                short wy = (short)windings[index].y;
-                fwrite(&wx, sizeof(short), 1, binFile);
-                fwrite(&wy, sizeof(short), 1, binFile);
-                index++;
-            }
-        }
-
-        free(windings);
-        free(winding_lengths);
-        stbtt_FreeShape(&font, stbVertex);
-    }
-
-    // 计算实际偏移地址并回写到索引区域
-    for (int i = 0; i < unique_len; ++i) {
-        fseek(binFile, glyphOffsets[i], SEEK_SET);
-        int glyphDataStartOffset = glyphDataStartOffsets[i];
-        fwrite(&glyphDataStartOffset, sizeof(int), 1, binFile);
-    }
-
-    free(glyphOffsets);
-    free(glyphDataStartOffsets);
-    free(utf16_text);
-    free(ttfBuffer);
-    free(fontSet->fontName);
-    fclose(binFile);
-
-    return 0;
-}
-
-void printFontSet(const FontSet *fontSet) {
-    printf("FontSet Information:\n");
-    printf("Length: %d\n", fontSet->length);
-    printf("FileFlag: %d\n", fontSet->fileFlag);
-    printf("Version: %.4s\n", fontSet->version);
-    printf("FontSize: %d\n", fontSet->fontSize);
-    printf("RenderMode: %d\n", fontSet->renderMode);
-    printf("Bold: %d\n", fontSet->bold);
-    printf("Italic: %d\n", fontSet->italic);
-    printf("ScanMode: %d\n", fontSet->scanMode);
-    printf("IndexMethod: %d\n", fontSet->indexMethod);
-    printf("IndexAreaSize: %d\n", fontSet->indexAreaSize);
-    printf("FontNameLength: %d\n", fontSet->fontNameLength);
-    printf("Ascent: %d\n", fontSet->ascent);
-    printf("Descent: %d\n", fontSet->descent);
-    printf("LineGap: %d\n", fontSet->lineGap);
-    printf("FontName: %s\n", fontSet->fontName);
-}
-
-
-void readBinFile(const char *binPath) {
-    FILE *binFile = fopen(binPath, "rb");
-    if (!binFile) {
-        fprintf(stderr, "Error opening BIN file!\n");
-        return;
-    }
-
-    fseek(binFile, 0, SEEK_END);
-    long size = ftell(binFile);
-    fseek(binFile, 0, SEEK_SET);
-
-    if (size < sizeof(char)) {
-        fprintf(stderr, "BIN file is too small!\n");
-        fclose(binFile);
-        return;
-    }
-
-    FontSet fontSet;
-    fread(&fontSet.length, sizeof(char), 1, binFile);
-    fread(&fontSet.fileFlag, sizeof(char), 1, binFile);
-    fread(fontSet.version, sizeof(char), 4, binFile);
-    fread(&fontSet.fontSize, sizeof(char), 1, binFile);
-    fread(&fontSet.renderMode, sizeof(char), 1, binFile);
-
-    unsigned char flagByte;
-    fread(&flagByte, sizeof(char), 1, binFile);
-    fontSet.bold = (flagByte >> 7) & 1;
-    fontSet.italic = (flagByte >> 6) & 1;
-    fontSet.scanMode = (flagByte >> 5) & 1;
-    fontSet.indexMethod = (flagByte >> 4) & 1;
-
-    fread(&fontSet.indexAreaSize, sizeof(int), 1, binFile);
-    fread(&fontSet.fontNameLength, sizeof(uint8_t), 1, binFile);
-    fread(&fontSet.ascent, sizeof(short), 1, binFile);
-    fread(&fontSet.descent, sizeof(short), 1, binFile);
-    fread(&fontSet.lineGap, sizeof(short), 1, binFile);
-
-    fontSet.fontName = (char *)malloc(fontSet.fontNameLength + 1);
-    if (!fontSet.fontName) {
-        fprintf(stderr, "Memory allocation error for font name!\n");
-        fclose(binFile);
-        return;
-    }
-    fread(fontSet.fontName, sizeof(char), fontSet.fontNameLength, binFile);
-    fontSet.fontName[fontSet.fontNameLength] = '\0';
-
-    // 打印 FontSet 结构体内容
-    printFontSet(&fontSet);
-
-    if (fontSet.indexAreaSize <= 0) {
-        fprintf(stderr, "Index area size is invalid!\n");
-        free(fontSet.fontName);
-        fclose(binFile);
-        return;
-    }
-
-    GlyphEntry *glyphEntries = (GlyphEntry *)malloc(fontSet.indexAreaSize);
-    if (!glyphEntries) {
-        fprintf(stderr, "Memory allocation error for glyph entries!\n");
-        free(fontSet.fontName);
-        fclose(binFile);
-        return;
-    }
-
-    int entryCount = fontSet.indexAreaSize / sizeof(GlyphEntry);
-    for (int i = 0; i < entryCount; ++i) {
-        if (fread(&glyphEntries[i].unicode, sizeof(uint16_t), 1, binFile) != 1 ||
-            fread(&glyphEntries[i].offset, sizeof(uint32_t), 1, binFile) != 1) {
-            fprintf(stderr, "Error reading glyph entry!\n");
-            free(glyphEntries);
-            free(fontSet.fontName);
-            fclose(binFile);
-            return;
-        }
-    }
-
-    // 打印前三个字的 Unicode 编码及其在文件中的地址
-    printf("Index\tUnicode\tAddress\n");
-    for (int i = 0; i < entryCount && i < 3; ++i) {
-        printf("%d\t0x%04X\t0x%08X\n", i + 1, glyphEntries[i].unicode, glyphEntries[i].offset);
-    }
-
-    // 打印第一个字的全部信息
-    if (entryCount > 0) {
-        fseek(binFile, glyphEntries[0].offset, SEEK_SET);
-
-        short x0, y0, x1, y1;
-        if (fread(&x0, sizeof(short), 1, binFile) != 1 ||
-            fread(&y0, sizeof(short), 1, binFile) != 1 ||
-            fread(&x1, sizeof(short), 1, binFile) != 1 ||
-            fread(&y1, sizeof(short), 1, binFile) != 1) {
-            fprintf(stderr, "Error reading glyph bounding box!\n");
-            free(glyphEntries);
-            free(fontSet.fontName);
-            fclose(binFile);
-            return;
-        }
-
-        short advance;
-        if (fread(&advance, sizeof(short), 1, binFile) != 1) {
-            fprintf(stderr, "Error reading glyph advance!\n");
-            free(glyphEntries);
-            free(fontSet.fontName);
-            fclose(binFile);
-            return;
-        }
-
-    printf("Character: 0x%04X, x0: %d, y0: %d, x1: %d, y1: %d, advance: %d\n",
-           glyphEntries[0].unicode, x0, y0, x1, y1, advance);
-
-        uint8_t winding_count;
-        if (fread(&winding_count, sizeof(uint8_t), 1, binFile) != 1) {
-            fprintf(stderr, "Error reading winding count!\n");
-            free(glyphEntries);
-            free(fontSet.fontName);
-            fclose(binFile);
-            return;
-        }
-
-        printf("Number of winding paths: %d\n", winding_count);
-
-        uint8_t *winding_lengths = (uint8_t *)malloc(winding_count * sizeof(uint8_t));
-        if (!winding_lengths) {
-            fprintf(stderr, "Memory allocation error for winding lengths!\n");
-            free(glyphEntries);
-            free(fontSet.fontName);
-            fclose(binFile);
-            return;
-        }
-
-        if (fread(winding_lengths, sizeof(uint8_t), winding_count, binFile) != winding_count) {
-            fprintf(stderr, "Error reading winding lengths!\n");
-            free(winding_lengths);
-            free(glyphEntries);
-            free(fontSet.fontName);
-            fclose(binFile);
-            return;
-        }
-
-        for (int j = 0; j < winding_count; ++j) {
-            printf("Winding %d has %d segments\n", j, winding_lengths[j]);
-            for (int k = 0; k < winding_lengths[j]; ++k) {
-                short wx, wy;
-                if (fread(&wx, sizeof(short), 1, binFile) != 1 ||
-                    fread(&wy, sizeof(short), 1, binFile) != 1) {
-                    fprintf(stderr, "Error reading windings data!\n");
-                    free(winding_lengths);
-                    free(glyphEntries);
-                    free(fontSet.fontName);
-                    fclose(binFile);
-                    return;
-                }
-                // printf("Character: 0x%04X, Winding Point %d-%d: x = %d, y = %d\n", glyphEntries[0].unicode, j, k, wx, wy);
-            }
-        }
-
-        free(winding_lengths);
-    }
-
-    free(glyphEntries);
-    free(fontSet.fontName);
-    fclose(binFile);
-}
-
-// 返回指定 Unicode 字符在二进制文件中的字形数据偏移地址，不存在则返回 0
-int getGlyphOffsetFromBinFile(uint16_t unicode, const char *binFilePath) {
-    FILE *binFile = fopen(binFilePath, "rb");
-    if (!binFile) {
-        fprintf(stderr, "Error opening BIN file %s!\n", binFilePath);
-        return 0;
-    }
-
-    FontSet fontSetHeader;
-
-    // 读取并跳过第一个头部数据块
-    fread(&fontSetHeader.length, sizeof(char), 1, binFile);
-    fseek(binFile, 1 + 4 + 1 + 1, SEEK_CUR); // 跳过其余部分:fileFlag（1字节）, version（4字节）， fontSize（1字节）， renderMode（1字节）
-
-    // 读取和解析标志字节
-    unsigned char flags;
-    fread(&flags, sizeof(unsigned char), 1, binFile);
-    fontSetHeader.bold = (flags >> 7) & 0x01;
-    fontSetHeader.italic = (flags >> 6) & 0x01;
-    fontSetHeader.scanMode = (flags >> 5) & 0x01;
-    fontSetHeader.indexMethod = (flags >> 4) & 0x01;
-    fontSetHeader.rsvd = flags & 0x0F;
-
-    // 读取 indexAreaSize
-    fread(&fontSetHeader.indexAreaSize, sizeof(int), 1, binFile);
-
-    // 跳过其余头部数据
-    fread(&fontSetHeader.fontNameLength, sizeof(uint8_t), 1, binFile);
-    fseek(binFile, sizeof(short) * 3 + fontSetHeader.fontNameLength, SEEK_CUR);  // 跳过 ascent, descent, lineGap 和 fontName
-
-    // 读取并解析索引区
-    int indexEntries = fontSetHeader.indexAreaSize / (sizeof(uint16_t) + sizeof(int));
-    for (int i = 0; i < indexEntries; ++i) {
-        uint16_t currentUnicode;
-        fread(&currentUnicode, sizeof(uint16_t), 1, binFile);
-
-        int glyphOffset;
-        fread(&glyphOffset, sizeof(int), 1, binFile);
-
-        if (currentUnicode == unicode) {
-            fclose(binFile);
-            return glyphOffset;
-        }
-    }
-
-    fclose(binFile);
-    return 0;
-}
-
-// 模拟从内存中获取指定 Unicode 字符的字形数据偏移地址
-int getGlyphOffsetFromMemory(uint16_t unicode, const uint8_t *mem) {
-    const uint8_t *ptr = mem;
-
-    // 跳过无用头部信息直到 indexAreaSize (13 字节: 1+1+4+1+1+1)
-    ptr += 9;
-
-    // 读取 indexAreaSize
-    int indexAreaSize = *(int*)ptr;
-    ptr += sizeof(int);
-
-    // 跳过其余无用头部信息 (即: fontNameLength, ascent, descent, lineGap, 和 fontName)
-    uint8_t fontNameLength = *ptr;
-    ptr += 1 + sizeof(short) * 3 + fontNameLength;
-
-    // 读取并解析索引区
-    int indexEntries = indexAreaSize / (sizeof(uint16_t) + sizeof(int));
-    for (int i = 0; i < indexEntries; ++i) {
-        uint16_t currentUnicode = *(uint16_t*)ptr;
-        ptr += sizeof(uint16_t);
-
-        int glyphOffset = *(int*)ptr;
-        ptr += sizeof(int);
-
-        if (currentUnicode == unicode) {
-            return glyphOffset;
-        }
-    }
-
-    return 0;
-}
-
-int readFontGlyphData(const uint8_t *mem, int offset, FontGlyphData *glyphData) {
-    const uint8_t *ptr = mem + offset;
-
-    // 读取基本的坐标和计数
-    size_t winding_byte_offset = offsetof(FontGlyphData, winding_lengths);
-    memcpy(&glyphData->sx0, ptr, winding_byte_offset);
-    ptr += winding_byte_offset;
-
-    // 分配并读取 winding_lengths
-    glyphData->winding_lengths = (uint8_t *)malloc(glyphData->winding_count * sizeof(uint8_t));
-    if (!glyphData->winding_lengths) {
-        fprintf(stderr, "Memory allocation failed for winding_lengths!\n");
-        return -1;
-    }
-    memcpy(glyphData->winding_lengths, ptr, glyphData->winding_count);
-    ptr += glyphData->winding_count;
-
-    // 计算线条数量
-    int line_count = 0;
-    for (int i = 0; i < glyphData->winding_count; ++i) {
-        line_count += glyphData->winding_lengths[i];
-    }
-
-    // 分配并读取 windings
-    glyphData->windings = (short *)malloc(line_count * 2 * sizeof(short));
-    if (!glyphData->windings) {
-        fprintf(stderr, "Memory allocation failed for windings!\n");
-        free(glyphData->winding_lengths);
-        return -1;
-    }
-    memcpy(glyphData->windings, ptr, line_count * 2 * sizeof(short));
-
-    return 0; // 成功
-}
-
-
-
-
-// 模拟从文件读取整个文件到内存中
-uint8_t* loadFileToMemory(const char *filePath, int *length) {
-    FILE *file = fopen(filePath, "rb");
-    if (!file) {
-        fprintf(stderr, "Error opening file %s!\n", filePath);
-        return NULL;
-    }
-
-    fseek(file, 0, SEEK_END);
-    *length = ftell(file);
-    fseek(file, 0, SEEK_SET);
-
-    uint8_t *buffer = (uint8_t*)malloc(*length);
-    if (!buffer) {
-        fprintf(stderr, "Memory allocation failed!\n");
-        fclose(file);
-        return NULL;
-    }
-
-    fread(buffer, 1, *length, file);
-    fclose(file);
-
-    return buffer;
-}
-
-int main() {
-    FontSet fontSet = {
-        .fileFlag = 2,
-        .version = { '1', '0', '0', '4' },
-        .fontSize = 32,
-        .renderMode = 4,
-        .bold = 0,
-        .italic = 0,
-        .scanMode = 0,
-        .indexMethod = 1,
-        .indexAreaSize = 0,
-        .fontNameLength = 0,
-        .ascent = 0,
-        .descent = 0,
-        .lineGap = 0,
-        .fontName = NULL
-    };
-
-    /*ascii, CP500*/
-    const char *ascii = "!\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
-    const char *twgx = "滕王高阁临江渚，佩玉鸣鸾罢歌舞。画栋朝飞南浦云，珠帘暮卷西山雨。闲云潭影日悠悠，物换星移几度秋。阁中帝子今何在？槛外长江空自流。";
-    const char *twgx_ascii = "滕王高阁临江渚，佩玉鸣鸾罢歌舞。画栋朝飞南浦云，珠帘暮卷西山雨。闲云潭影日悠悠，物换星移几度秋。阁中帝子今何在？槛外长江空自流。!\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
-
-    const char *binname = "harmony_32_4.bin";
-    int result = generateBinFile("HarmonyOS_Sans_SC_Regular.ttf", binname, ascii, &fontSet);
-    // STXihei.ttf
-    // STXINGKA.TTF
-    // HarmonyOS_Sans_SC_Regular.ttf
-    if (result == 0) {
-        readBinFile(binname);
-    }
-
-    const char *binFilePath = binname;
-    // uint16_t unicode = 0x738B;  // 例如：Unicode字符"王"
-
-    // int offset = getGlyphOffsetFromBinFile(unicode, binFilePath);
-    // if (offset) {
-    //     printf("Glyph offset for Unicode 0x%X is %d\n", unicode, offset);
-    // } else {
-    //     printf("Unicode 0x%X not found in the file.\n", unicode);
-    // }
-
-    int fileLength = 0;    // 将文件加载到内存中
-    uint8_t *memoryBuffer = loadFileToMemory(binFilePath, &fileLength);
-    if (!memoryBuffer) {
-        return -1;
-    }
-
-    uint16_t unicode = 0x738B;  // 例如：Unicode字符"王"
-    int offset = getGlyphOffsetFromMemory(unicode, memoryBuffer);
-    if (offset) {
-        printf("Glyph offset for Unicode 0x%X is %d\n", unicode, offset);
-
-        FontGlyphData glyphData;
-        if (readFontGlyphData(memoryBuffer, offset, &glyphData) == 0) {
-            // 打印基本数据以验证
-            printf("sx0: %d, sy0: %d, sx1: %d, sy1: %d\n",
-                   glyphData.sx0, glyphData.sy0, glyphData.sx1, glyphData.sy1);
-            printf("winding_count: %d\n", glyphData.winding_count);
-
-            // 打印 winding_lengths
-            printf("winding_lengths:");
-            for (int i = 0; i < glyphData.winding_count; ++i) {
-                printf(" %d", glyphData.winding_lengths[i]);
-            }
-            printf("\n");
-
-            // 打印 windings (x, y)
-            printf("windings:");
-            int line_count = 0;
-            for (int i = 0; i < glyphData.winding_count; ++i) {
-                line_count += glyphData.winding_lengths[i];
-            }
-            for (int i = 0; i < line_count; ++i) {
-                printf(" (%d, %d)", glyphData.windings[2 * i], glyphData.windings[2 * i + 1]);
-            }
-            printf("\n");
-
-            // 释放分配的内存
-            free(glyphData.winding_lengths);
-            free(glyphData.windings);
-        }
-    } else {
-        printf("Unicode 0x%X not found in memory.\n", unicode);
-    }
-
-
-    free(memoryBuffer);
-    return 0;
-}
-
+// strdup、clock_gettime 等 POSIX 接口在 -std=c11 下不会自动声明
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <errno.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <sys/utime.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <utime.h>
+#endif
+
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+// 分离布局索引的码位查找每次比较多个码位：按编译目标选择 AVX2、SSE2 或 NEON，
+// 编译时定义 INDEX_SEARCH_SCALAR 可强制使用标量实现
+#if !defined(INDEX_SEARCH_SCALAR)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define INDEX_SEARCH_LANES 16
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define INDEX_SEARCH_LANES 8
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define INDEX_SEARCH_LANES 8
+#endif
+#endif
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "stb_truetype.h"
+#include "charset_presets.h"
+
+
+// 定义 FontSet 结构体
+typedef struct {
+    char length;
+    char fileFlag;
+    char version[4];
+    char fontSize;
+    char renderMode;
+    unsigned char bold : 1;
+    unsigned char italic : 1;
+    unsigned char scanMode : 1;
+    unsigned char indexMethod : 1;
+    unsigned char rsvd : 4;
+    int indexAreaSize;
+    uint8_t fontNameLength;
+    short ascent;
+    short descent;
+    short lineGap;
+    char *fontName;
+    uint8_t quantBits;  // 量化格式的坐标位数，写在扩展头部；其他格式为 0
+    uint8_t fixedPointBits;  // 非 0 时坐标、度量为 fontSize 下的定点像素，小数位数写在扩展头部
+    float fontScale;         // 与 fixedPointBits 一起写入：字体单位到 fontSize 像素的缩放比例
+    uint8_t indexLayout;     // 索引区布局 INDEX_LAYOUT_*，非交错布局时写在扩展头部
+    uint64_t fontHash;       // 非 0 时写在扩展头部：生成时 TTF 内容的哈希，增量更新据此确认字体没有变化
+    float simplifyTolerance; // 非 0 时写在扩展头部：轮廓简化的像素容差，增量更新据此确认记录可以复用
+} FontSet;
+
+// 扩展头部：位于 fontName 之后、索引区之前，由若干 [tag, size, data] 组成，头部的 length 包含这部分。
+// 不带扩展字段时文件布局与原来完全相同；读取端按 length 定位索引区，跳过不认识的字段
+#define HEADER_EXT_QUANT_BITS 1  // 1 字节：OUTLINE_FORMAT_QUANTIZED 的坐标位数
+#define HEADER_EXT_PIXEL_SPACE 2 // 5 字节：定点像素坐标的小数位数 + 字体单位到像素的缩放比例（float）
+#define HEADER_EXT_INDEX_LAYOUT 3 // 1 字节索引区布局，之后是使索引区起始按 4 字节对齐的 0 填充
+#define HEADER_EXT_FONT_HASH  4  // 8 字节：TTF 内容哈希（与字形缓存键相同的 hashBytes）
+#define HEADER_EXT_SIMPLIFY   5  // 4 字节：轮廓简化的像素容差（float）
+
+// 索引区布局。交错、分离布局的项数都是 indexAreaSize / 6
+#define INDEX_LAYOUT_INTERLEAVED 0  // 每项 2 字节码位 + 4 字节偏移依次排列
+#define INDEX_LAYOUT_SPLIT       1  // 全部码位（uint16）在前，补齐到 4 字节后是全部偏移（uint32），两个数组都自然对齐
+#define INDEX_LAYOUT_RANGES      2  // uint32 段数 + 连续码位合并成的 IndexRange 段，补齐到 4 字节后是按序号排列的全部偏移（uint32）
+#define INDEX_LAYOUT_PAGED       3  // 256 个 IndexPage（按码位高字节分桶）+ 各项码位的低字节（uint8），补齐到 4 字节后是全部偏移（uint32）
+
+// 两级索引的一页：高字节为页号的码位是第 start 项开始的 count 项，桶内按低字节严格升序
+typedef struct {
+    uint16_t start;
+    uint16_t count;
+} IndexPage;
+
+#define INDEX_PAGE_COUNT 256
+
+// 分段布局中的一段：码位 start .. start + count - 1 依次对应偏移数组中 firstSlot 开始的 count 项。
+// 段按起始码位严格升序、互不重叠，firstSlot 为之前各段 count 之和
+typedef struct {
+    uint16_t start;
+    uint16_t count;
+    uint16_t firstSlot;
+} IndexRange;
+
+// 头部 length 字段按无符号 1 字节读取；固定字段共 20 字节，之后是字体名和扩展头部
+#define FONTSET_LENGTH_MAX   255
+#define FONTSET_FIXED_LENGTH 20
+
+// 定点像素坐标的小数位数上限，fontSize << 小数位数不能超过 FIXED_POINT_LIMIT，给超出 em 框的字形留出余量
+#define FIXED_POINT_BITS_MAX 8
+#define FIXED_POINT_LIMIT    8191
+
+typedef struct {
+    uint16_t unicode;
+    uint32_t offset;
+} GlyphEntry;
+
+// 索引偏移最高位：该码位在字体中不存在，低 31 位指向共享的缺字（.notdef）记录
+#define GLYPH_OFFSET_MISSING 0x80000000u
+#define GLYPH_OFFSET_MASK    0x7FFFFFFFu
+
+// 文件头 version 字段。只用到原始格式（raw 轮廓、交错索引、没有扩展头部、校验和与缺字标记）的文件仍写 1004，
+// 与原来的读取代码完全兼容；用到其中任何一项时写 1005，只认 1004 的读取代码据此拒绝，而不是把这些位当作 0 误读
+#define FONTSET_VERSION_BASE     "1004"
+#define FONTSET_VERSION_EXTENDED "1005"
+
+// 标志字节 indexMethod 位：索引区的组织方式，读取端据此选择查找方法
+#define INDEX_METHOD_LINEAR 0  // 索引项顺序任意，逐项比较
+#define INDEX_METHOD_SORTED 1  // 索引项按码位严格升序排列，二分查找
+
+// 标志字节 rsvd 位：文件末尾带 CRC32C 校验和
+#define FONTSET_FLAG_CHECKSUM 0x08
+
+// 标志字节 rsvd 低 3 位：字形记录中轮廓点的编码格式
+#define OUTLINE_FORMAT_MASK  0x07
+#define OUTLINE_FORMAT_RAW   0  // 每个点两个 short，字体单位
+#define OUTLINE_FORMAT_DELTA 1  // 每个点相对前一个点的差值（第一个点相对原点），zigzag 后按 varint 存储
+#define OUTLINE_FORMAT_CURVES 2 // 保留曲线：轮廓点之后是每点 2 位的类型，渲染时再按实际字号展平
+#define OUTLINE_FORMAT_QUANTIZED 3  // 每个坐标量化为字形包围盒内的 n 位整数，n 记录在扩展头部
+#define OUTLINE_FORMAT_EDGES  4 // 扫描线边表：包围盒、advance 之后是 u16 边数和按起始 y 排好序的 GlyphEdge，定点像素坐标
+
+// 边表格式中的一条边，y 向下（与光栅化的扫描方向一致），坐标为定点像素，见文件头的 fixedPointBits。
+// 水平边已去掉，y0 < y1；记录中按 y0（相同时按 x0）升序排列，各字段依次紧密存放，共 12 字节
+typedef struct {
+    short y0;         // 上端
+    short y1;         // 下端
+    short x0;         // y0 处的 x
+    short direction;  // 原轮廓中边向下为 1，向上为 -1，用于非零环绕规则
+    int32_t dxdy;     // 每向下一个单位 x 的变化量，16.16 定点
+} GlyphEdge;
+
+// 边表格式未指定 --fixed-point 时使用 26.6
+#define EDGE_TABLE_FIXED_POINT_BITS 6
+
+// 量化格式的坐标位数范围；解码只需要 32 位整数运算
+#define QUANT_BITS_MIN     4
+#define QUANT_BITS_MAX     12
+#define QUANT_BITS_DEFAULT 8
+
+// 曲线格式中每个点的类型，按点的顺序每字节存 4 个，低位在前
+#define POINT_TYPE_ON    0  // 轮廓上的点：直线或曲线的终点
+#define POINT_TYPE_QUAD  1  // 二次曲线的控制点
+#define POINT_TYPE_CUBIC 2  // 三次曲线的控制点，两个连续出现
+
+// 校验和尾部：magic "C32C" + 之前全部字节的 CRC32C
+#define CHECKSUM_MAGIC        0x43323343u
+#define CHECKSUM_TRAILER_SIZE 8
+
+// 缺失字形的处理方式
+#define MISSING_GLYPH_NOTDEF 0  // 索引保留，指向共享的 .notdef 记录并置 GLYPH_OFFSET_MISSING
+#define MISSING_GLYPH_OMIT   1  // 不写入索引
+#define MISSING_GLYPH_EMPTY  2  // 与原来的格式相同：索引保留，不写记录，偏移与下一条写入的记录相同
+
+// 定义 FontGlyphData 结构体用于保存字形数据信息
+typedef struct {
+    short sx0;
+    short sy0;
+    short sx1;
+    short sy1;
+    short advance;
+    uint8_t winding_count;
+    uint8_t *winding_lengths;
+    short *windings;
+} FontGlyphData;
+
+
+// 函数声明
+int calculateFontSetLength(const FontSet *fontSet);
+uint16_t* utf8_to_utf16(const char* utf8_str, int* length);
+int generateBinFile(const char *ttfPath, const char *binPath, const char *text, FontSet *fontSet);
+
+typedef struct GlyphCache GlyphCache;
+typedef struct GlyphLookup GlyphLookup;
+typedef struct GenerateProfile GenerateProfile;
+
+// 生成选项
+typedef struct {
+    int threadCount;         // 字形提取线程数，1 为单线程，0 为按 CPU 核数自动选择
+    GlyphCache *glyphCache;  // 非空时先查询磁盘字形缓存
+    uint64_t fontHash;       // TTF 内容哈希，作为缓存键的一部分；为 0 时由 generateBinFileFromMemory 计算
+    const GlyphLookup *glyphLookup;  // 非空时用预先建好的码位→字形表，必须与字体对应
+    int dedupGlyphs;         // 内容完全相同的字形记录只写一份，索引共用同一偏移
+    int missingGlyphs;       // MISSING_GLYPH_*，缺省为 MISSING_GLYPH_EMPTY
+    GenerateProfile *profile;  // 非空时记录各阶段耗时和每个字形的统计，不能在并发任务之间共享
+    int checksum;            // 文件末尾追加 CRC32C 校验和，并置 FONTSET_FLAG_CHECKSUM；缺省不追加
+    int outlineFormat;       // OUTLINE_FORMAT_*，记录在标志字节的 rsvd 低 3 位
+    float simplifyTolerance; // 展平后按 Douglas-Peucker 简化轮廓的容差，单位为 fontSize 下的像素，0 表示不简化
+    int quantBits;           // OUTLINE_FORMAT_QUANTIZED 的坐标位数，QUANT_BITS_MIN..QUANT_BITS_MAX
+    int fixedPointBits;      // 非 0 时输出 fontSize 下的定点像素坐标（例如 6 为 26.6），0 为字体单位
+    int indexLayout;         // INDEX_LAYOUT_*
+    int recordFontHash;      // 把 fontHash 写入扩展头部，之后的增量更新才能复用字形记录；增量更新的输出总是写入
+} GenerateOptions;
+
+void initGenerateOptions(GenerateOptions *options);
+int generateBinFileEx(const char *ttfPath, const char *binPath, const char *text, FontSet *fontSet, const GenerateOptions *options);
+int generateBinFileFromMemory(const unsigned char *ttfData, size_t ttfSize, const char *binPath, const char *text, FontSet *fontSet, const GenerateOptions *options);
+int generateBinFileFromFont(const stbtt_fontinfo *font, const char *binPath, const char *text, FontSet *fontSet, const GenerateOptions *options);
+int generateBinFileFromCodepoints(const stbtt_fontinfo *font, const char *binPath, const uint16_t *codepoints, int count, FontSet *fontSet, const GenerateOptions *options);
+int generateBinFileFromGlyphs(const stbtt_fontinfo *font, const char *binPath, const uint16_t *codepoints, const uint16_t *glyphIndices,
+                              int count, FontSet *fontSet, const GenerateOptions *options);
+int generateBinFileFullCoverage(const stbtt_fontinfo *font, const char *binPath, FontSet *fontSet, const GenerateOptions *options);
+
+// 头部总长度，包括扩展头部和对齐填充；写入文件的 length 只有 1 字节，超过 FONTSET_LENGTH_MAX 时不能生成
+int calculateFontSetLength(const FontSet *fontSet) {
+    int length = 1  // length
+         + 1  // fileFlag
+         + 4  // version
+         + 1  // fontSize
+         + 1  // renderMode
+         + 1  // flags (bold, italic, scanMode, indexMethod, rsvd)
+         + 4  // indexAreaSize
+         + 1  // fontNameLength
+         + 2  // ascent
+         + 2  // descent
+         + 2  // lineGap
+         + fontSet->fontNameLength  // fontName length
+         + (fontSet->quantBits ? 2 + 1 : 0)  // 扩展头部
+         + (fontSet->fixedPointBits ? 2 + 1 + 4 : 0)
+         + (fontSet->fontHash ? 2 + 8 : 0)
+         + (fontSet->simplifyTolerance > 0 ? 2 + 4 : 0);
+    if (fontSet->indexLayout != INDEX_LAYOUT_INTERLEAVED) {
+        length += 2 + 1;
+        length += (4 - length % 4) % 4;  // 索引区起始对齐到 4 字节
+    }
+    return length;
+}
+
+// 分离布局中码位数组占用的字节数，包括偏移数组之前的对齐填充
+static size_t getSplitIndexKeyBytes(int count) {
+    return ((size_t)count * sizeof(uint16_t) + 3) & ~(size_t)3;
+}
+
+// 分段布局中偏移数组之前的字节数：段数、全部段以及对齐填充
+static size_t getRangeIndexHeaderBytes(int segmentCount) {
+    return sizeof(uint32_t) + (((size_t)segmentCount * sizeof(IndexRange) + 3) & ~(size_t)3);
+}
+
+// 两级索引中偏移数组之前的字节数：页表、低字节数组以及对齐填充
+static size_t getPagedIndexHeaderBytes(int count) {
+    return INDEX_PAGE_COUNT * sizeof(IndexPage) + (((size_t)count + 3) & ~(size_t)3);
+}
+
+// count 项索引区的总字节数，segmentCount 只对分段布局有意义
+static int getIndexAreaSize(int indexLayout, int count, int segmentCount) {
+    if (indexLayout == INDEX_LAYOUT_SPLIT) return (int)(getSplitIndexKeyBytes(count) + (size_t)count * sizeof(uint32_t));
+    if (indexLayout == INDEX_LAYOUT_RANGES) return (int)(getRangeIndexHeaderBytes(segmentCount) + (size_t)count * sizeof(uint32_t));
+    if (indexLayout == INDEX_LAYOUT_PAGED) return (int)(getPagedIndexHeaderBytes(count) + (size_t)count * sizeof(uint32_t));
+    return count * (2 + 4);
+}
+
+// 第 i 项的码位相对索引区起始的位置，分段布局不单独存放码位
+static size_t getIndexKeyPosition(int indexLayout, int i) {
+    return indexLayout == INDEX_LAYOUT_SPLIT ? (size_t)i * sizeof(uint16_t) : (size_t)i * (2 + 4);
+}
+
+// 第 i 项的偏移相对索引区起始的位置
+static size_t getIndexOffsetPosition(int indexLayout, int count, int segmentCount, int i) {
+    if (indexLayout == INDEX_LAYOUT_SPLIT) return getSplitIndexKeyBytes(count) + (size_t)i * sizeof(uint32_t);
+    if (indexLayout == INDEX_LAYOUT_RANGES) return getRangeIndexHeaderBytes(segmentCount) + (size_t)i * sizeof(uint32_t);
+    if (indexLayout == INDEX_LAYOUT_PAGED) return getPagedIndexHeaderBytes(count) + (size_t)i * sizeof(uint32_t);
+    return (size_t)i * (2 + 4) + 2;
+}
+
+// 升序码位列表中连续码位段的个数，每段最多 65535 个码位
+static int countCodepointRuns(const uint16_t *codepoints, int count) {
+    int runs = 0;
+    for (int i = 0, length = 0; i < count; ++i) {
+        if (i == 0 || codepoints[i] != codepoints[i - 1] + 1 || length == 0xFFFF) {
+            runs++;
+            length = 0;
+        }
+        length++;
+    }
+    return runs;
+}
+
+// 分段布局索引区中的段数和项数，index 指向索引区起始；格式错误时返回 -1
+static int getRangeIndexCounts(const uint8_t *index, int indexAreaSize, int *segmentCount) {
+    uint32_t segments;
+    if (indexAreaSize < (int)sizeof(uint32_t)) return -1;
+    memcpy(&segments, index, sizeof(uint32_t));
+    if (segments > 0xFFFF || getRangeIndexHeaderBytes((int)segments) > (size_t)indexAreaSize) return -1;
+    size_t offsetBytes = (size_t)indexAreaSize - getRangeIndexHeaderBytes((int)segments);
+    if (offsetBytes % sizeof(uint32_t) != 0) return -1;
+    *segmentCount = (int)segments;
+    return (int)(offsetBytes / sizeof(uint32_t));
+}
+
+// 两级索引的项数，即各页 count 之和；各页不是依次相接或与索引区长度不符时返回 -1
+static int getPagedIndexCount(const uint8_t *index, int indexAreaSize) {
+    if (indexAreaSize < (int)(INDEX_PAGE_COUNT * sizeof(IndexPage))) return -1;
+    int count = 0;
+    for (int page = 0; page < INDEX_PAGE_COUNT; ++page) {
+        IndexPage entry;
+        memcpy(&entry, index + page * sizeof(IndexPage), sizeof(IndexPage));
+        if (entry.start != count || entry.count > 256) return -1;
+        count += entry.count;
+    }
+    return getIndexAreaSize(INDEX_LAYOUT_PAGED, count, 0) == indexAreaSize ? count : -1;
+}
+
+// 索引区的项数，index 指向索引区起始；分段布局同时取出段数。格式错误时返回 -1
+static int getIndexEntryCount(int indexLayout, const uint8_t *index, int indexAreaSize, int *segmentCount) {
+    *segmentCount = 0;
+    if (indexLayout == INDEX_LAYOUT_RANGES) return getRangeIndexCounts(index, indexAreaSize, segmentCount);
+    if (indexLayout == INDEX_LAYOUT_PAGED) return getPagedIndexCount(index, indexAreaSize);
+    return indexAreaSize / (2 + 4);
+}
+
+// 在一页升序的低字节中查找，返回页内序号，未找到返回 -1。
+// 一页最多 256 个低字节、不超过 4 条 cache line，无分支二分查找至多 8 轮
+static int findPageKey(const uint8_t *keys, int count, uint8_t low) {
+    if (count <= 0) return -1;
+    const uint8_t *base = keys;
+    for (int n = count; n > 1; ) {
+        int half = n / 2;
+        base += base[half] <= low ? half : 0;
+        n -= half;
+    }
+    return *base == low ? (int)(base - keys) : -1;
+}
+
+// 在两级索引中查找码位，返回其在偏移数组中的序号，未找到返回 -1。高字节直接定位到页，查找耗时与字数无关
+static int findPagedSlot(const uint8_t *index, uint16_t unicode) {
+    const IndexPage *page = (const IndexPage *)index + (unicode >> 8);
+    int k = findPageKey(index + INDEX_PAGE_COUNT * sizeof(IndexPage) + page->start, page->count, (uint8_t)unicode);
+    return k < 0 ? -1 : page->start + k;
+}
+
+// 在 segmentCount 个段中查找码位，返回其在偏移数组中的序号，不在任何段内时返回 -1。
+// 段的起始码位做无分支的二分查找，之后只需一次范围检查；只有一段（例如完整的 ASCII）时直接比较
+static int findRangeSlot(const IndexRange *ranges, int segmentCount, uint16_t unicode) {
+    if (segmentCount <= 0) return -1;
+    const IndexRange *base = ranges;
+    for (int n = segmentCount; n > 1; ) {
+        int half = n / 2;
+        base += base[half].start <= unicode ? half : 0;
+        n -= half;
+    }
+    unsigned int delta = (unsigned int)unicode - base->start;  // unicode 小于起始码位时回绕为很大的数
+    return delta < base->count ? base->firstSlot + (int)delta : -1;
+}
+
+uint16_t* utf8_to_utf16(const char* utf8_str, int* length) {
+    int utf16_len = 0;
+    const char *ptr = utf8_str;
+    uint16_t *utf16_str;
+
+    while (*ptr) {
+        unsigned char c = (unsigned char)*ptr;
+        if (c < 0x80) {
+            utf16_len++;
+            ptr++;
+        } else if (c < 0xE0) {
+            utf16_len++;
+            ptr += 2;
+        } else if (c < 0xF0) {
+            utf16_len++;
+            ptr += 3;
+        } else {
+            utf16_len++;
+            ptr += 4;
+        }
+    }
+
+    utf16_str = (uint16_t*)malloc((utf16_len + 1) * sizeof(uint16_t));
+    if (!utf16_str) {
+        *length = 0;
+        return NULL;
+    }
+
+    ptr = utf8_str;
+    uint16_t *out = utf16_str;
+    while (*ptr) {
+        unsigned char c = (unsigned char)*ptr;
+        if (c < 0x80) {
+            *out++ = c;
+            ptr++;
+        } else if (c < 0xE0) {
+            *out++ = ((c & 0x1F) << 6) | (ptr[1] & 0x3F);
+            ptr += 2;
+        } else if (c < 0xF0) {
+            *out++ = ((c & 0x0F) << 12) | ((ptr[1] & 0x3F) << 6) | (ptr[2] & 0x3F);
+            ptr += 3;
+        } else {
+            *out++ = ((c & 0x07) << 18) | ((ptr[1] & 0x3F) << 12) | ((ptr[2] & 0x3F) << 6) | (ptr[3] & 0x3F);
+            ptr += 4;
+        }
+    }
+    *out = 0;
+
+    *length = utf16_len;
+    return utf16_str;
+}
+
+// BMP 字符集：每个码位占一位，插入 O(1)，按位遍历即为升序
+typedef struct {
+    uint64_t bits[65536 / 64];
+} Charset;
+
+void charsetClear(Charset *set) {
+    memset(set->bits, 0, sizeof(set->bits));
+}
+
+void charsetAdd(Charset *set, uint16_t codepoint) {
+    set->bits[codepoint >> 6] |= 1ULL << (codepoint & 63);
+}
+
+int charsetContains(const Charset *set, uint16_t codepoint) {
+    return (int)((set->bits[codepoint >> 6] >> (codepoint & 63)) & 1);
+}
+
+void charsetUnion(Charset *dst, const Charset *src) {
+    for (int i = 0; i < 65536 / 64; ++i) {
+        dst->bits[i] |= src->bits[i];
+    }
+}
+
+void charsetIntersect(Charset *dst, const Charset *src) {
+    for (int i = 0; i < 65536 / 64; ++i) {
+        dst->bits[i] &= src->bits[i];
+    }
+}
+
+void charsetSubtract(Charset *dst, const Charset *src) {
+    for (int i = 0; i < 65536 / 64; ++i) {
+        dst->bits[i] &= ~src->bits[i];
+    }
+}
+
+void charsetAddRange(Charset *set, uint16_t first, uint16_t last) {
+    for (uint32_t c = first; c <= last; ++c) {
+        charsetAdd(set, (uint16_t)c);
+    }
+}
+
+static void charsetAddCjkBits(Charset *set, const uint32_t *bits) {
+    for (int i = 0; i < CHARSET_PRESET_CJK_WORDS; ++i) {
+        // CJK 基址按 64 位对齐，两个 32 位字拼成一个 64 位字
+        int codepoint = CHARSET_PRESET_CJK_BASE + i * 32;
+        set->bits[codepoint >> 6] |= (uint64_t)bits[i] << (codepoint & 63);
+    }
+}
+
+// 内置字符集：ascii（0x21–0x7E 可见字符）、gb2312-1、gb2312-2、gb2312（含 1–9 区符号）、big5-common；
+// 未知名称返回 -1
+int charsetAddPreset(Charset *set, const char *name) {
+    if (strcmp(name, "ascii") == 0) {
+        charsetAddRange(set, 0x21, 0x7E);
+    } else if (strcmp(name, "gb2312-1") == 0) {
+        charsetAddCjkBits(set, gb2312Level1Bits);
+    } else if (strcmp(name, "gb2312-2") == 0) {
+        charsetAddCjkBits(set, gb2312Level2Bits);
+    } else if (strcmp(name, "gb2312") == 0) {
+        charsetAddCjkBits(set, gb2312Level1Bits);
+        charsetAddCjkBits(set, gb2312Level2Bits);
+        for (size_t i = 0; i < sizeof(gb2312Symbols) / sizeof(gb2312Symbols[0]); ++i) {
+            charsetAdd(set, gb2312Symbols[i]);
+        }
+    } else if (strcmp(name, "big5-common") == 0) {
+        charsetAddCjkBits(set, big5CommonBits);
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+static int popcount64(uint64_t value) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(value);
+#else
+    int count = 0;
+    while (value) {
+        value &= value - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+int charsetCount(const Charset *set) {
+    int count = 0;
+    for (int i = 0; i < 65536 / 64; ++i) {
+        count += popcount64(set->bits[i]);
+    }
+    return count;
+}
+
+// 按升序导出码位，返回数量；*codepoints 由调用方释放
+int charsetToArray(const Charset *set, uint16_t **codepoints) {
+    int count = charsetCount(set);
+    *codepoints = (uint16_t *)malloc((count > 0 ? count : 1) * sizeof(uint16_t));
+    if (!*codepoints) return -1;
+
+    int n = 0;
+    for (int i = 0; i < 65536 / 64; ++i) {
+        uint64_t word = set->bits[i];
+        while (word) {
+#if defined(__GNUC__)
+            int bit = __builtin_ctzll(word);
+#else
+            int bit = 0;
+            while (!((word >> bit) & 1)) bit++;
+#endif
+            (*codepoints)[n++] = (uint16_t)(i * 64 + bit);
+            word &= word - 1;
+        }
+    }
+    return n;
+}
+
+// 流式 UTF-8 解码状态：多字节序列可以跨越两次输入的分块边界
+typedef struct {
+    uint32_t codepoint;
+    int remaining;        // 当前序列还差几个后续字节
+    int sequenceLength;
+    long invalidCount;    // 非法或截断的序列
+    long supplementaryCount;  // BMP 以外的码位（bin 格式只支持 16 位 unicode，跳过）
+} Utf8Decoder;
+
+void utf8DecoderInit(Utf8Decoder *decoder) {
+    memset(decoder, 0, sizeof(Utf8Decoder));
+}
+
+static void utf8DecoderEmit(Utf8Decoder *decoder, uint32_t codepoint, Charset *set) {
+    if (codepoint > 0xFFFF) {
+        decoder->supplementaryCount++;
+    } else if (codepoint >= 0x20 && codepoint != 0x7F && codepoint != 0xFEFF &&
+               (codepoint < 0xD800 || codepoint > 0xDFFF)) {
+        // 控制字符、BOM 和代理区码位没有字形，不加入字符集
+        charsetAdd(set, (uint16_t)codepoint);
+    }
+}
+
+// 解码一块 UTF-8 数据并把码位加入 set，不要求分块落在字符边界上
+void utf8DecodeChunk(Utf8Decoder *decoder, const uint8_t *data, size_t size, Charset *set) {
+    static const uint32_t minimumCodepoint[5] = { 0, 0, 0x80, 0x800, 0x10000 };
+
+    for (size_t i = 0; i < size; ++i) {
+        uint8_t c = data[i];
+
+        if (decoder->remaining > 0) {
+            if ((c & 0xC0) == 0x80) {
+                decoder->codepoint = (decoder->codepoint << 6) | (c & 0x3F);
+                if (--decoder->remaining == 0) {
+                    // 拒绝过长编码
+                    if (decoder->codepoint >= minimumCodepoint[decoder->sequenceLength] && decoder->codepoint <= 0x10FFFF) {
+                        utf8DecoderEmit(decoder, decoder->codepoint, set);
+                    } else {
+                        decoder->invalidCount++;
+                    }
+                }
+                continue;
+            }
+            // 序列被截断，当前字节按新序列的开头重新处理
+            decoder->invalidCount++;
+            decoder->remaining = 0;
+        }
+
+        if (c < 0x80) {
+            utf8DecoderEmit(decoder, c, set);
+        } else if ((c & 0xE0) == 0xC0) {
+            decoder->codepoint = c & 0x1F;
+            decoder->remaining = 1;
+            decoder->sequenceLength = 2;
+        } else if ((c & 0xF0) == 0xE0) {
+            decoder->codepoint = c & 0x0F;
+            decoder->remaining = 2;
+            decoder->sequenceLength = 3;
+        } else if ((c & 0xF8) == 0xF0) {
+            decoder->codepoint = c & 0x07;
+            decoder->remaining = 3;
+            decoder->sequenceLength = 4;
+        } else {
+            decoder->invalidCount++;
+        }
+    }
+}
+
+// 输入结束时调用，统计末尾未完成的序列
+void utf8DecoderFinish(Utf8Decoder *decoder) {
+    if (decoder->remaining > 0) {
+        decoder->invalidCount++;
+        decoder->remaining = 0;
+    }
+}
+
+// 把一段以 '\0' 结尾的 UTF-8 文本中的字符加入字符集
+void charsetAddUtf8Text(Charset *set, const char *text) {
+    Utf8Decoder decoder;
+    utf8DecoderInit(&decoder);
+    utf8DecodeChunk(&decoder, (const uint8_t *)text, strlen(text), set);
+    utf8DecoderFinish(&decoder);
+}
+
+// cmap 遍历回调：glyphIndex 为 0 的映射不会回调
+typedef void (*CmapVisitor)(uint32_t codepoint, int glyphIndex, void *user);
+
+// 按 stbtt_InitFont 选定的 cmap 子表一次性列出全部 (码位, 字形) 映射，
+// 取值规则与 stbtt_FindGlyphIndex 保持一致，避免对 64K 个码位逐个二分查找。
+// 支持 format 0/4/6/12/13，其他格式退回逐码位查询 BMP
+void enumerateCmap(const stbtt_fontinfo *font, CmapVisitor visit, void *user) {
+    stbtt_uint8 *data = font->data;
+    stbtt_uint32 indexMap = font->index_map;
+    stbtt_uint16 format = ttUSHORT(data + indexMap);
+
+    if (format == 0) {
+        int bytes = ttUSHORT(data + indexMap + 2);
+        for (int c = 0; c < bytes - 6 && c < 256; ++c) {
+            int glyphIndex = ttBYTE(data + indexMap + 6 + c);
+            if (glyphIndex) visit((uint32_t)c, glyphIndex, user);
+        }
+    } else if (format == 6) {
+        uint32_t first = ttUSHORT(data + indexMap + 6);
+        uint32_t count = ttUSHORT(data + indexMap + 8);
+        for (uint32_t i = 0; i < count; ++i) {
+            int glyphIndex = ttUSHORT(data + indexMap + 10 + i * 2);
+            if (glyphIndex) visit(first + i, glyphIndex, user);
+        }
+    } else if (format == 4) {
+        // 段按 endCode 升序排列；idRangeOffset 非 0 时从 glyphIdArray 取值
+        uint32_t segCount = ttUSHORT(data + indexMap + 6) >> 1;
+        uint32_t endCodes = indexMap + 14;
+        uint32_t startCodes = endCodes + segCount * 2 + 2;
+        uint32_t idDeltas = startCodes + segCount * 2;
+        uint32_t idRangeOffsets = idDeltas + segCount * 2;
+        for (uint32_t s = 0; s < segCount; ++s) {
+            uint32_t start = ttUSHORT(data + startCodes + s * 2);
+            uint32_t end = ttUSHORT(data + endCodes + s * 2);
+            stbtt_int16 delta = ttSHORT(data + idDeltas + s * 2);
+            uint32_t rangeOffset = ttUSHORT(data + idRangeOffsets + s * 2);
+            for (uint32_t c = start; c <= end; ++c) {
+                int glyphIndex;
+                if (rangeOffset == 0) {
+                    glyphIndex = (stbtt_uint16)(c + delta);
+                } else {
+                    glyphIndex = ttUSHORT(data + idRangeOffsets + s * 2 + rangeOffset + (c - start) * 2);
+                }
+                if (glyphIndex) visit(c, glyphIndex, user);
+            }
+        }
+    } else if (format == 12 || format == 13) {
+        uint32_t groupCount = ttULONG(data + indexMap + 12);
+        for (uint32_t g = 0; g < groupCount; ++g) {
+            uint32_t start = ttULONG(data + indexMap + 16 + g * 12);
+            uint32_t end = ttULONG(data + indexMap + 16 + g * 12 + 4);
+            uint32_t startGlyph = ttULONG(data + indexMap + 16 + g * 12 + 8);
+            if (end > 0x10FFFF) end = 0x10FFFF;
+            for (uint32_t c = start; c <= end; ++c) {
+                int glyphIndex = (int)(format == 12 ? startGlyph + (c - start) : startGlyph);
+                if (glyphIndex) visit(c, glyphIndex, user);
+            }
+        }
+    } else {
+        for (uint32_t c = 0; c <= 0xFFFF; ++c) {
+            int glyphIndex = stbtt_FindGlyphIndex(font, (int)c);
+            if (glyphIndex) visit(c, glyphIndex, user);
+        }
+    }
+}
+
+// 每个字体建一次的码位→字形表：BMP 用 64K 的数组直接下标访问，
+// 辅助平面的映射较少，按码位排序后二分查找
+struct GlyphLookup {
+    uint16_t *bmp;
+    uint32_t *supplementaryCodepoints;
+    uint16_t *supplementaryGlyphs;
+    int supplementaryCount;
+    int supplementaryCapacity;
+    int error;
+};
+
+static void addGlyphLookupEntry(uint32_t codepoint, int glyphIndex, void *user) {
+    GlyphLookup *lookup = (GlyphLookup *)user;
+    if (codepoint <= 0xFFFF) {
+        if (lookup->bmp[codepoint] == 0) lookup->bmp[codepoint] = (uint16_t)glyphIndex;
+        return;
+    }
+
+    if (lookup->supplementaryCount == lookup->supplementaryCapacity) {
+        int capacity = lookup->supplementaryCapacity ? lookup->supplementaryCapacity * 2 : 256;
+        uint32_t *codepoints = (uint32_t *)realloc(lookup->supplementaryCodepoints, capacity * sizeof(uint32_t));
+        if (codepoints) lookup->supplementaryCodepoints = codepoints;
+        uint16_t *glyphs = (uint16_t *)realloc(lookup->supplementaryGlyphs, capacity * sizeof(uint16_t));
+        if (glyphs) lookup->supplementaryGlyphs = glyphs;
+        if (!codepoints || !glyphs) {
+            lookup->error = 1;
+            return;
+        }
+        lookup->supplementaryCapacity = capacity;
+    }
+    lookup->supplementaryCodepoints[lookup->supplementaryCount] = codepoint;
+    lookup->supplementaryGlyphs[lookup->supplementaryCount] = (uint16_t)glyphIndex;
+    lookup->supplementaryCount++;
+}
+
+void glyphLookupFree(GlyphLookup *lookup) {
+    free(lookup->bmp);
+    free(lookup->supplementaryCodepoints);
+    free(lookup->supplementaryGlyphs);
+    memset(lookup, 0, sizeof(GlyphLookup));
+}
+
+// 遍历一次 cmap 建表，之后同一字体的所有任务只读共享
+int glyphLookupBuild(GlyphLookup *lookup, const stbtt_fontinfo *font) {
+    memset(lookup, 0, sizeof(GlyphLookup));
+    lookup->bmp = (uint16_t *)calloc(0x10000, sizeof(uint16_t));
+    if (!lookup->bmp) {
+        fprintf(stderr, "Memory allocation error for glyph lookup table!\n");
+        return -1;
+    }
+    enumerateCmap(font, addGlyphLookupEntry, lookup);
+    if (lookup->error) {
+        fprintf(stderr, "Memory allocation error for glyph lookup table!\n");
+        glyphLookupFree(lookup);
+        return -1;
+    }
+
+    // format 12 的分组本身有序，这里插入排序只是防御乱序的字体，重复码位保留第一个
+    int count = 0;
+    for (int i = 0; i < lookup->supplementaryCount; ++i) {
+        uint32_t codepoint = lookup->supplementaryCodepoints[i];
+        uint16_t glyph = lookup->supplementaryGlyphs[i];
+        int j = count;
+        while (j > 0 && lookup->supplementaryCodepoints[j - 1] > codepoint) {
+            lookup->supplementaryCodepoints[j] = lookup->supplementaryCodepoints[j - 1];
+            lookup->supplementaryGlyphs[j] = lookup->supplementaryGlyphs[j - 1];
+            j--;
+        }
+        if (j > 0 && lookup->supplementaryCodepoints[j - 1] == codepoint) {
+            for (; j < count; ++j) {
+                lookup->supplementaryCodepoints[j] = lookup->supplementaryCodepoints[j + 1];
+                lookup->supplementaryGlyphs[j] = lookup->supplementaryGlyphs[j + 1];
+            }
+            continue;
+        }
+        lookup->supplementaryCodepoints[j] = codepoint;
+        lookup->supplementaryGlyphs[j] = glyph;
+        count++;
+    }
+    lookup->supplementaryCount = count;
+    return 0;
+}
+
+// 码位对应的字形，不存在时为 0
+static inline int glyphLookupFind(const GlyphLookup *lookup, uint32_t codepoint) {
+    if (codepoint <= 0xFFFF) return lookup->bmp[codepoint];
+
+    int low = 0;
+    int high = lookup->supplementaryCount;
+    while (low < high) {
+        int mid = low + ((high - low) >> 1);
+        if (lookup->supplementaryCodepoints[mid] < codepoint) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low < lookup->supplementaryCount && lookup->supplementaryCodepoints[low] == codepoint) {
+        return lookup->supplementaryGlyphs[low];
+    }
+    return 0;
+}
+
+// 字体覆盖的 BMP 码位及对应字形，按码位升序
+typedef struct {
+    uint16_t *codepoints;
+    uint16_t *glyphIndices;
+    int count;
+} FontCoverage;
+
+// 由码位→字形表列出字体覆盖的全部 BMP 字符
+int getFontCoverage(const GlyphLookup *lookup, FontCoverage *coverage) {
+    memset(coverage, 0, sizeof(FontCoverage));
+
+    int count = 0;
+    for (uint32_t c = 0; c <= 0xFFFF; ++c) {
+        if (lookup->bmp[c]) count++;
+    }
+    coverage->codepoints = (uint16_t *)malloc((count > 0 ? count : 1) * sizeof(uint16_t));
+    coverage->glyphIndices = (uint16_t *)malloc((count > 0 ? count : 1) * sizeof(uint16_t));
+    if (!coverage->codepoints || !coverage->glyphIndices) {
+        fprintf(stderr, "Memory allocation error for font coverage!\n");
+        free(coverage->codepoints);
+        free(coverage->glyphIndices);
+        return -1;
+    }
+    for (uint32_t c = 0; c <= 0xFFFF; ++c) {
+        if (lookup->bmp[c]) {
+            coverage->codepoints[coverage->count] = (uint16_t)c;
+            coverage->glyphIndices[coverage->count] = lookup->bmp[c];
+            coverage->count++;
+        }
+    }
+    return 0;
+}
+
+void freeFontCoverage(FontCoverage *coverage) {
+    free(coverage->codepoints);
+    free(coverage->glyphIndices);
+    memset(coverage, 0, sizeof(FontCoverage));
+}
+
+typedef struct {
+    uint16_t unicode;
+    uint32_t offset;
+    uint32_t length; // 增加一个长度字段以存储绘制字形的信息长度
+    void *glyphData; // 直接保存对应的字形信息（包括轮廓和线段信息）
+} GlyphData;
+
+// FNV-1a 64 位哈希，seed 传入上一段的结果可以串联多段数据
+uint64_t hashBytes(const void *data, size_t size, uint64_t seed) {
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint64_t hash = seed ? seed : 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// CRC32C（Castagnoli，反射多项式 0x82F63B78）。有 SSE4.2 / ARMv8 CRC 指令时使用硬件指令，
+// 否则按 slice-by-8 每次处理 8 字节；两种实现结果相同，与字节序无关
+#if !defined(__SSE4_2__) && !defined(__ARM_FEATURE_CRC32)
+static uint32_t crc32cTable[8][256];
+
+// 由 pthread_once / InitOnceExecuteOnce 保证只初始化一次，其他线程在初始化完成后才能看到表
+static void crc32cInitTable(void) {
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int k = 0; k < 8; ++k) {
+            crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1)));
+        }
+        crc32cTable[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; ++i) {
+        for (int t = 1; t < 8; ++t) {
+            crc32cTable[t][i] = (crc32cTable[t - 1][i] >> 8) ^ crc32cTable[0][crc32cTable[t - 1][i] & 0xFF];
+        }
+    }
+}
+
+#ifdef _WIN32
+static INIT_ONCE crc32cTableOnce = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK crc32cInitTableOnce(PINIT_ONCE once, PVOID parameter, PVOID *context) {
+    (void)once;
+    (void)parameter;
+    (void)context;
+    crc32cInitTable();
+    return TRUE;
+}
+#else
+static pthread_once_t crc32cTableOnce = PTHREAD_ONCE_INIT;
+#endif
+#endif
+
+// 与 zlib 的 crc32() 用法相同：首次传入 0，分段计算时传入上一段的结果
+uint32_t crc32c(uint32_t crc, const void *data, size_t size) {
+    const uint8_t *p = (const uint8_t *)data;
+    crc = ~crc;
+
+#if defined(__SSE4_2__) || defined(__ARM_FEATURE_CRC32)
+    for (; size >= 8; size -= 8, p += 8) {
+        uint64_t word;
+        memcpy(&word, p, 8);
+#if defined(__SSE4_2__) && defined(__x86_64__)
+        crc = (uint32_t)_mm_crc32_u64(crc, word);
+#elif defined(__SSE4_2__)
+        crc = _mm_crc32_u32(crc, (uint32_t)word);
+        crc = _mm_crc32_u32(crc, (uint32_t)(word >> 32));
+#else
+        crc = __crc32cd(crc, word);
+#endif
+    }
+    for (; size > 0; --size, ++p) {
+#if defined(__SSE4_2__)
+        crc = _mm_crc32_u8(crc, *p);
+#else
+        crc = __crc32cb(crc, *p);
+#endif
+    }
+#else
+#ifdef _WIN32
+    InitOnceExecuteOnce(&crc32cTableOnce, crc32cInitTableOnce, NULL, NULL);
+#else
+    pthread_once(&crc32cTableOnce, crc32cInitTable);
+#endif
+    for (; size >= 8; size -= 8, p += 8) {
+        uint32_t one = crc ^ ((uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24));
+        uint32_t two = (uint32_t)p[4] | ((uint32_t)p[5] << 8) | ((uint32_t)p[6] << 16) | ((uint32_t)p[7] << 24);
+        crc = crc32cTable[7][one & 0xFF] ^ crc32cTable[6][(one >> 8) & 0xFF] ^
+              crc32cTable[5][(one >> 16) & 0xFF] ^ crc32cTable[4][one >> 24] ^
+              crc32cTable[3][two & 0xFF] ^ crc32cTable[2][(two >> 8) & 0xFF] ^
+              crc32cTable[1][(two >> 16) & 0xFF] ^ crc32cTable[0][two >> 24];
+    }
+    for (; size > 0; --size, ++p) {
+        crc = (crc >> 8) ^ crc32cTable[0][(crc ^ *p) & 0xFF];
+    }
+#endif
+
+    return ~crc;
+}
+
+// 检查文件末尾的校验和：1 校验通过，0 文件不带校验和，-1 校验和不符或文件被截断
+int verifyBinChecksum(const uint8_t *data, size_t size) {
+    if (size < 9 || !(data[8] & FONTSET_FLAG_CHECKSUM)) return 0;
+    if (size < 9 + CHECKSUM_TRAILER_SIZE) return -1;
+
+    uint32_t trailer[2];
+    memcpy(trailer, data + size - CHECKSUM_TRAILER_SIZE, CHECKSUM_TRAILER_SIZE);
+    if (trailer[0] != CHECKSUM_MAGIC) return -1;
+    return crc32c(0, data, size - CHECKSUM_TRAILER_SIZE) == trailer[1] ? 1 : -1;
+}
+
+// 输出缓冲区：整个 bin 文件先在内存中拼装，偏移量原地回填，最后一次性写出
+typedef struct {
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+    int error;  // 任意一次扩容失败后置 1，之后的写入全部忽略
+} OutputBuffer;
+
+void outputBufferInit(OutputBuffer *buf, size_t initialCapacity) {
+    buf->data = NULL;
+    buf->size = 0;
+    buf->capacity = 0;
+    buf->error = 0;
+    if (initialCapacity > 0) {
+        buf->data = (uint8_t *)malloc(initialCapacity);
+        if (buf->data) {
+            buf->capacity = initialCapacity;
+        } else {
+            buf->error = 1;
+        }
+    }
+}
+
+int outputBufferReserve(OutputBuffer *buf, size_t extra) {
+    if (buf->error) return -1;
+    if (buf->size + extra <= buf->capacity) return 0;
+
+    size_t newCapacity = buf->capacity ? buf->capacity : 4096;
+    while (newCapacity < buf->size + extra) {
+        newCapacity *= 2;
+    }
+
+    uint8_t *newData = (uint8_t *)realloc(buf->data, newCapacity);
+    if (!newData) {
+        buf->error = 1;
+        return -1;
+    }
+    buf->data = newData;
+    buf->capacity = newCapacity;
+    return 0;
+}
+
+void outputBufferWrite(OutputBuffer *buf, const void *src, size_t n) {
+    if (n == 0) return;
+    if (outputBufferReserve(buf, n) != 0) return;
+    memcpy(buf->data + buf->size, src, n);
+    buf->size += n;
+}
+
+// 回填已写入区域（例如索引区中的字形偏移）
+void outputBufferPatch(OutputBuffer *buf, size_t pos, const void *src, size_t n) {
+    if (buf->error || pos + n > buf->size) return;
+    memcpy(buf->data + pos, src, n);
+}
+
+int outputBufferSaveToFile(const OutputBuffer *buf, const char *path) {
+    if (buf->error) {
+        fprintf(stderr, "Memory allocation error for output buffer!\n");
+        return -1;
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        fprintf(stderr, "Error creating BIN file!\n");
+        return -1;
+    }
+
+    size_t written = fwrite(buf->data, 1, buf->size, file);
+    if (fclose(file) != 0 || written != buf->size) {
+        fprintf(stderr, "Error writing BIN file %s!\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+static uint32_t zigzagEncode(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t zigzagDecode(uint32_t value) {
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+// 每字节低 7 位为数据，最高位表示后面还有字节
+void outputBufferWriteVarint(OutputBuffer *buf, uint32_t value) {
+    uint8_t bytes[5];
+    size_t n = 0;
+    while (value >= 0x80) {
+        bytes[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    bytes[n++] = (uint8_t)value;
+    outputBufferWrite(buf, bytes, n);
+}
+
+void outputBufferFree(OutputBuffer *buf) {
+    free(buf->data);
+    buf->data = NULL;
+    buf->size = 0;
+    buf->capacity = 0;
+}
+
+// 按文件格式顺序序列化 FontSet 头部
+void serializeFontSetHeader(const FontSet *fontSet, OutputBuffer *out) {
+    size_t headerStart = out->size;
+    outputBufferWrite(out, &fontSet->length, sizeof(char));
+    outputBufferWrite(out, &fontSet->fileFlag, sizeof(char));
+    outputBufferWrite(out, fontSet->version, sizeof(char) * 4);
+    outputBufferWrite(out, &fontSet->fontSize, sizeof(char));
+    outputBufferWrite(out, &fontSet->renderMode, sizeof(char));
+
+    unsigned char flagByte = (fontSet->bold << 7) |
+                             (fontSet->italic << 6) |
+                             (fontSet->scanMode << 5) |
+                             (fontSet->indexMethod << 4) |
+                             fontSet->rsvd;
+    outputBufferWrite(out, &flagByte, sizeof(char));
+
+    outputBufferWrite(out, &fontSet->indexAreaSize, sizeof(int));
+    outputBufferWrite(out, &fontSet->fontNameLength, sizeof(uint8_t));
+    outputBufferWrite(out, &fontSet->ascent, sizeof(short));
+    outputBufferWrite(out, &fontSet->descent, sizeof(short));
+    outputBufferWrite(out, &fontSet->lineGap, sizeof(short));
+    outputBufferWrite(out, fontSet->fontName, sizeof(char) * fontSet->fontNameLength);
+
+    if (fontSet->quantBits) {
+        uint8_t field[3] = { HEADER_EXT_QUANT_BITS, 1, fontSet->quantBits };
+        outputBufferWrite(out, field, sizeof(field));
+    }
+    if (fontSet->fixedPointBits) {
+        uint8_t field[3] = { HEADER_EXT_PIXEL_SPACE, 1 + 4, fontSet->fixedPointBits };
+        outputBufferWrite(out, field, sizeof(field));
+        outputBufferWrite(out, &fontSet->fontScale, sizeof(float));
+    }
+    if (fontSet->fontHash) {
+        uint8_t field[2] = { HEADER_EXT_FONT_HASH, 8 };
+        outputBufferWrite(out, field, sizeof(field));
+        outputBufferWrite(out, &fontSet->fontHash, sizeof(uint64_t));
+    }
+    if (fontSet->simplifyTolerance > 0) {
+        uint8_t field[2] = { HEADER_EXT_SIMPLIFY, 4 };
+        outputBufferWrite(out, field, sizeof(field));
+        outputBufferWrite(out, &fontSet->simplifyTolerance, sizeof(float));
+    }
+    if (fontSet->indexLayout != INDEX_LAYOUT_INTERLEAVED) {
+        // 字段一直延伸到 length 处，多出的部分为对齐填充
+        uint8_t field[3 + 3] = { HEADER_EXT_INDEX_LAYOUT, 0, fontSet->indexLayout };
+        size_t fieldSize = (uint8_t)fontSet->length - (out->size - headerStart);
+        field[1] = (uint8_t)(fieldSize - 2);
+        outputBufferWrite(out, field, fieldSize);
+    }
+}
+
+// 字形提取参数：同一组参数下，同一个字形的序列化结果完全确定
+typedef struct {
+    float flatness;  // stbtt_FlattenCurves 的容差，单位为字体单位
+    int outlineFormat;  // OUTLINE_FORMAT_*
+    float simplify;  // 轮廓简化的容差，单位为字体单位，0 表示不简化
+    int quantBits;   // OUTLINE_FORMAT_QUANTIZED 的坐标位数
+    float pixelScale;  // 非 0 时输出定点像素坐标：字体单位乘以该值后取整
+} GlyphParams;
+
+// 缓存键中的参数部分；记录格式或提取参数变化时键随之变化
+uint64_t glyphParamsHash(const GlyphParams *params) {
+    // 原始格式保持为 1，已有的缓存继续有效
+    uint32_t recordFormat = 1 + (uint32_t)params->outlineFormat;
+    uint64_t hash = hashBytes(&recordFormat, sizeof(recordFormat), 0);
+    hash = hashBytes(&params->flatness, sizeof(params->flatness), hash);
+    if (params->simplify > 0) {
+        hash = hashBytes(&params->simplify, sizeof(params->simplify), hash);
+    }
+    if (params->outlineFormat == OUTLINE_FORMAT_QUANTIZED) {
+        hash = hashBytes(&params->quantBits, sizeof(params->quantBits), hash);
+    }
+    if (params->pixelScale > 0) {
+        hash = hashBytes(&params->pixelScale, sizeof(params->pixelScale), hash);
+    }
+    return hash;
+}
+
+// 单调时钟，单位毫秒
+double getTimeMs(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart * 1000.0 / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1000.0 + (double)now.tv_nsec / 1e6;
+#endif
+}
+
+// 生成过程的各个阶段
+#define PHASE_CMAP      0  // 码位→字形查询
+#define PHASE_SHAPE     1  // 读取字形轮廓、包围盒
+#define PHASE_FLATTEN   2  // 曲线展平
+#define PHASE_SERIALIZE 3  // 写字形记录
+#define PHASE_MERGE     4  // 拼接分片、去重、回填索引
+#define PHASE_IO        5  // 字形缓存读写、输出文件写入
+#define PHASE_COUNT     6
+
+static const char *const phaseNames[PHASE_COUNT] = { "cmap", "shape", "flatten", "serialize", "merge", "io" };
+
+typedef struct {
+    double ms[PHASE_COUNT];
+} PhaseTimes;
+
+// 曲线格式的轮廓部分：轮廓数量、各轮廓点数、点类型以及全部点（含控制点，按差值格式编码），取自 stbtt_GetGlyphShape
+// 两个二次控制点之间正好位于两者中点的轮廓点（TrueType 的隐含点）不存储，读取时按同样的公式还原；
+// 超过 255 个点的轮廓在轮廓点处拆成首尾相接的几段，拆分处补上的两条闭合边方向相反，填充结果不变
+static int writeCurveOutline(const stbtt_vertex *vertices, int vertexCount, OutputBuffer *out) {
+    int capacity = vertexCount * 3 + 1;
+    short *points = (short *)malloc(capacity * 2 * sizeof(short));
+    uint8_t *types = (uint8_t *)malloc(capacity);
+    int *starts = (int *)malloc((vertexCount + 2) * sizeof(int));
+    int *order = (int *)malloc(capacity * 3 * sizeof(int));    // 按写入顺序排列的点下标，拆分处的点出现两次
+    uint8_t *lengths = (uint8_t *)malloc(capacity * 2);
+    if (!points || !types || !starts || !order || !lengths) {
+        fprintf(stderr, "Memory allocation error for curve outline!\n");
+        free(points);
+        free(types);
+        free(starts);
+        free(order);
+        free(lengths);
+        return -1;
+    }
+
+    int contourCount = 0;
+    int pointCount = 0;
+    for (int i = 0; i < vertexCount; ++i) {
+        const stbtt_vertex *v = &vertices[i];
+        if (v->type == STBTT_vmove || contourCount == 0) starts[contourCount++] = pointCount;
+
+        if (v->type == STBTT_vcurve && pointCount - 2 > starts[contourCount - 1] &&
+            types[pointCount - 1] == POINT_TYPE_ON && types[pointCount - 2] == POINT_TYPE_QUAD &&
+            points[2 * (pointCount - 1)] == ((points[2 * (pointCount - 2)] + v->cx) >> 1) &&
+            points[2 * (pointCount - 1) + 1] == ((points[2 * (pointCount - 2) + 1] + v->cy) >> 1)) {
+            pointCount--;  // 隐含点
+        }
+
+        short controls[4] = { v->cx, v->cy, v->cx1, v->cy1 };
+        int controlCount = v->type == STBTT_vcurve ? 1 : v->type == STBTT_vcubic ? 2 : 0;
+        for (int k = 0; k < controlCount; ++k) {
+            points[2 * pointCount] = controls[2 * k];
+            points[2 * pointCount + 1] = controls[2 * k + 1];
+            types[pointCount++] = v->type == STBTT_vcurve ? POINT_TYPE_QUAD : POINT_TYPE_CUBIC;
+        }
+        points[2 * pointCount] = v->x;
+        points[2 * pointCount + 1] = v->y;
+        types[pointCount++] = POINT_TYPE_ON;
+    }
+    starts[contourCount] = pointCount;
+
+    int orderCount = 0;
+    int pieceCount = 0;
+    for (int c = 0; c < contourCount; ++c) {
+        int first = starts[c];
+        int length = starts[c + 1] - first;
+        int sequenceStart = orderCount;
+        for (int i = first; i < first + length; ++i) {
+            order[orderCount++] = i;
+        }
+        if (length > 255 && (points[2 * first] != points[2 * (first + length - 1)] ||
+                             points[2 * first + 1] != points[2 * (first + length - 1) + 1])) {
+            order[orderCount++] = first;  // 拆分前先显式闭合
+        }
+
+        // 每段最多 255 个点，在最靠后的轮廓点处断开，下一段从这个点开始
+        int remaining = orderCount - sequenceStart;
+        int *sequence = (int *)malloc(remaining * sizeof(int));
+        if (!sequence) {
+            fprintf(stderr, "Memory allocation error for curve outline!\n");
+            free(points);
+            free(types);
+            free(starts);
+            free(order);
+            free(lengths);
+            return -1;
+        }
+        memcpy(sequence, &order[sequenceStart], remaining * sizeof(int));
+        orderCount = sequenceStart;
+        int position = 0;
+        while (remaining - position > 255) {
+            int cut = position + 254;
+            while (cut > position + 1 && types[sequence[cut]] != POINT_TYPE_ON) cut--;
+            memcpy(&order[orderCount], &sequence[position], (cut - position + 1) * sizeof(int));
+            orderCount += cut - position + 1;
+            lengths[pieceCount++] = (uint8_t)(cut - position + 1);
+            position = cut;
+        }
+        memcpy(&order[orderCount], &sequence[position], (remaining - position) * sizeof(int));
+        orderCount += remaining - position;
+        lengths[pieceCount++] = (uint8_t)(remaining - position);
+        free(sequence);
+    }
+
+    if (pieceCount > 255) {
+        fprintf(stderr, "Too many contours in glyph!\n");
+        free(points);
+        free(types);
+        free(starts);
+        free(order);
+        free(lengths);
+        return -1;
+    }
+    outputBufferReserve(out, 1 + pieceCount + (orderCount + 3) / 4 + (size_t)orderCount * 2 * 3);
+    uint8_t pieceCountU8 = (uint8_t)pieceCount;
+    outputBufferWrite(out, &pieceCountU8, sizeof(uint8_t));
+    outputBufferWrite(out, lengths, pieceCount);
+    for (int i = 0; i < orderCount; i += 4) {
+        uint8_t packed = 0;
+        for (int k = 0; k < 4 && i + k < orderCount; ++k) {
+            packed |= types[order[i + k]] << (k * 2);
+        }
+        outputBufferWrite(out, &packed, sizeof(uint8_t));
+    }
+    short previous[2] = { 0, 0 };
+    for (int i = 0; i < orderCount; ++i) {
+        const short *point = &points[2 * order[i]];
+        outputBufferWriteVarint(out, zigzagEncode(point[0] - previous[0]));
+        outputBufferWriteVarint(out, zigzagEncode(point[1] - previous[1]));
+        previous[0] = point[0];
+        previous[1] = point[1];
+    }
+
+    free(points);
+    free(types);
+    free(starts);
+    free(order);
+    free(lengths);
+    return 0;
+}
+
+// 量化坐标还原为字体单位：origin 为包围盒下沿，extent 为包围盒宽（高），四舍五入；编码和解码共用
+static int dequantizeCoordinate(uint32_t value, int origin, int extent, int bits) {
+    uint32_t maxValue = (1u << bits) - 1;
+    return origin + (int)((value * (uint32_t)extent * 2 + maxValue) / (2 * maxValue));
+}
+
+// 把轮廓点量化为包围盒内的 bits 位整数，x、y 交替，低位在前连续存放，末尾补齐到整字节。
+// box 为 x 和 y 方向的 origin、extent；maxError 记录还原后与原坐标的最大距离（字体单位）
+static void writeQuantizedPoints(const stbtt__point *points, int count, const int box[4], int bits, OutputBuffer *out, float *maxError) {
+    uint32_t maxValue = (1u << bits) - 1;
+    uint32_t bitBuffer = 0;
+    int bitCount = 0;
+    for (int j = 0; j < count; ++j) {
+        int coordinate[2] = { (short)points[j].x, (short)points[j].y };
+        float squaredError = 0;
+        for (int axis = 0; axis < 2; ++axis) {
+            int origin = box[2 * axis], extent = box[2 * axis + 1];
+            int v = coordinate[axis] - origin;
+            v = v < 0 ? 0 : v > extent ? extent : v;  // 包围盒外的点夹到边上，误差计入统计
+            int value = extent > 0 ? (int)(((uint32_t)v * maxValue * 2 + extent) / (2 * (uint32_t)extent)) : 0;
+
+            // 还原时再次取整，相邻的量化值可能更接近
+            int best = value, bestError = abs(dequantizeCoordinate(value, origin, extent, bits) - coordinate[axis]);
+            for (int candidate = value - 1; candidate <= value + 1; candidate += 2) {
+                if (candidate < 0 || candidate > (int)maxValue) continue;
+                int error = abs(dequantizeCoordinate(candidate, origin, extent, bits) - coordinate[axis]);
+                if (error < bestError) {
+                    best = candidate;
+                    bestError = error;
+                }
+            }
+            squaredError += (float)bestError * bestError;
+
+            bitBuffer |= (uint32_t)best << bitCount;
+            bitCount += bits;
+            while (bitCount >= 8) {
+                uint8_t byte = (uint8_t)bitBuffer;
+                outputBufferWrite(out, &byte, sizeof(uint8_t));
+                bitBuffer >>= 8;
+                bitCount -= 8;
+            }
+        }
+        if (maxError && sqrtf(squaredError) > *maxError) *maxError = sqrtf(squaredError);
+    }
+    if (bitCount > 0) {
+        uint8_t byte = (uint8_t)bitBuffer;
+        outputBufferWrite(out, &byte, sizeof(uint8_t));
+    }
+}
+
+static int compareGlyphEdge(const void *a, const void *b) {
+    const GlyphEdge *ea = (const GlyphEdge *)a, *eb = (const GlyphEdge *)b;
+    if (ea->y0 != eb->y0) return ea->y0 - eb->y0;
+    return ea->x0 - eb->x0;
+}
+
+// 把已经换算为定点像素的轮廓转成边表：每个轮廓首尾相连，y 翻转为向下，去掉水平边后按起始 y 排序
+static int writeEdgeTable(const stbtt__point *points, const int *lengths, int windingCount, OutputBuffer *out) {
+    int pointCount = 0;
+    for (int j = 0; j < windingCount; ++j) {
+        pointCount += lengths[j];
+    }
+    GlyphEdge *edges = (GlyphEdge *)malloc((pointCount > 0 ? pointCount : 1) * sizeof(GlyphEdge));
+    if (!edges) {
+        fprintf(stderr, "Memory allocation error for edge table!\n");
+        return -1;
+    }
+
+    int edgeCount = 0;
+    const stbtt__point *contour = points;
+    for (int j = 0; j < windingCount; contour += lengths[j++]) {
+        for (int k = 0, previous = lengths[j] - 1; k < lengths[j]; previous = k++) {
+            int ax = (int)contour[previous].x, ay = -(int)contour[previous].y;
+            int bx = (int)contour[k].x, by = -(int)contour[k].y;
+            if (ay == by) continue;
+
+            GlyphEdge *edge = &edges[edgeCount++];
+            edge->direction = ay < by ? 1 : -1;
+            if (ay > by) {
+                int t = ax; ax = bx; bx = t;
+                t = ay; ay = by; by = t;
+            }
+            edge->y0 = (short)ay;
+            edge->y1 = (short)by;
+            edge->x0 = (short)ax;
+            edge->dxdy = (int32_t)floor((double)(bx - ax) * 65536.0 / (by - ay) + 0.5);
+        }
+    }
+    qsort(edges, edgeCount, sizeof(GlyphEdge), compareGlyphEdge);
+
+    if (edgeCount > 0xFFFF) {
+        fprintf(stderr, "Too many edges in glyph!\n");
+        free(edges);
+        return -1;
+    }
+    uint16_t edgeCountU16 = (uint16_t)edgeCount;
+    outputBufferWrite(out, &edgeCountU16, sizeof(uint16_t));
+    outputBufferWrite(out, edges, (size_t)edgeCount * sizeof(GlyphEdge));
+    free(edges);
+    return 0;
+}
+
+// 点到线段 ab 的距离
+static float pointSegmentDistance(const stbtt__point *p, const stbtt__point *a, const stbtt__point *b) {
+    float dx = b->x - a->x, dy = b->y - a->y;
+    float lengthSquared = dx * dx + dy * dy;
+    float t = lengthSquared > 0 ? ((p->x - a->x) * dx + (p->y - a->y) * dy) / lengthSquared : 0;
+    t = t < 0 ? 0 : t > 1 ? 1 : t;
+    float ex = a->x + t * dx - p->x, ey = a->y + t * dy - p->y;
+    return sqrtf(ex * ex + ey * ey);
+}
+
+// Douglas-Peucker 简化一个轮廓，原地压缩并返回剩余点数。删去的每个点到保留下来的对应线段的距离都不超过 tolerance，
+// 所以简化后的轮廓与原轮廓的距离不超过 tolerance。首尾点始终保留，隐式的闭合边不变
+static int simplifyContour(stbtt__point *points, int count, float tolerance) {
+    if (count < 4) return count;
+    uint8_t *keep = (uint8_t *)calloc(count, 1);
+    int *stack = (int *)malloc(count * 2 * sizeof(int));
+    if (!keep || !stack) {
+        free(keep);
+        free(stack);
+        return count;  // 内存不足时不简化
+    }
+
+    // 闭合轮廓首尾重合，先在离起点最远的点处分成两段
+    int farthest = 0;
+    float best = -1;
+    for (int i = 1; i < count - 1; ++i) {
+        float dx = points[i].x - points[0].x, dy = points[i].y - points[0].y;
+        if (dx * dx + dy * dy > best) {
+            best = dx * dx + dy * dy;
+            farthest = i;
+        }
+    }
+    keep[0] = keep[farthest] = keep[count - 1] = 1;
+    int top = 0;
+    stack[top++] = 0;
+    stack[top++] = farthest;
+    stack[top++] = farthest;
+    stack[top++] = count - 1;
+
+    while (top > 0) {
+        int b = stack[--top];
+        int a = stack[--top];
+        int index = -1;
+        float maxDistance = tolerance;
+        for (int i = a + 1; i < b; ++i) {
+            float distance = pointSegmentDistance(&points[i], &points[a], &points[b]);
+            if (distance > maxDistance) {
+                maxDistance = distance;
+                index = i;
+            }
+        }
+        if (index >= 0) {
+            keep[index] = 1;
+            stack[top++] = a;
+            stack[top++] = index;
+            stack[top++] = index;
+            stack[top++] = b;
+        }
+    }
+
+    int kept = 0;
+    for (int i = 0; i < count; ++i) {
+        if (keep[i]) points[kept++] = points[i];
+    }
+    free(keep);
+    free(stack);
+    return kept;
+}
+
+// 序列化单个字形：包围盒、advance、轮廓数量、各轮廓点数以及全部轮廓点
+// times 非空时把各阶段耗时累加进去；quantError 非空时记录量化格式的最大坐标误差（字体单位）
+int serializeGlyph(const stbtt_fontinfo *font, int glyphIndex, const GlyphParams *params, OutputBuffer *out, PhaseTimes *times,
+                   float *quantError) {
+    double start = times ? getTimeMs() : 0;
+    int x0, y0, x1, y1;
+    stbtt_GetGlyphBitmapBox(font, glyphIndex, 1.0, 1.0, &x0, &y0, &x1, &y1);
+
+    int advance, lsb;
+    stbtt_GetGlyphHMetrics(font, glyphIndex, &advance, &lsb);
+
+    if (params->pixelScale > 0) {
+        // 包围盒向外取整，保证仍然包住缩放后的轮廓
+        x0 = (int)floorf(x0 * params->pixelScale);
+        y0 = (int)floorf(y0 * params->pixelScale);
+        x1 = (int)ceilf(x1 * params->pixelScale);
+        y1 = (int)ceilf(y1 * params->pixelScale);
+        advance = (int)floorf(advance * params->pixelScale + 0.5f);
+    }
+
+    short header[5] = { (short)x0, (short)y0, (short)x1, (short)y1, (short)advance };
+    outputBufferWrite(out, header, sizeof(header));
+
+    stbtt_vertex *stbVertex = NULL;
+    int verCount = stbtt_GetGlyphShape(font, glyphIndex, &stbVertex);
+    double shaped = times ? getTimeMs() : 0;
+    if (params->outlineFormat == OUTLINE_FORMAT_CURVES) {
+        int result = writeCurveOutline(stbVertex, verCount, out);
+        stbtt_FreeShape(font, stbVertex);
+        if (times) {
+            times->ms[PHASE_SHAPE] += shaped - start;
+            times->ms[PHASE_SERIALIZE] += getTimeMs() - shaped;
+        }
+        return result == 0 && !out->error ? 0 : -1;
+    }
+
+    int winding_count = 0;
+    int *winding_lengths = NULL;
+    stbtt__point *windings = stbtt_FlattenCurves(stbVertex, verCount, params->flatness, &winding_lengths, &winding_count, NULL);
+
+    int pointCount = 0;
+    if (params->pixelScale > 0) {
+        // 直接由展平结果换算，只取整一次；之后的简化、量化都在定点像素坐标上进行
+        int flatCount = 0;
+        for (int j = 0; j < winding_count; ++j) {
+            flatCount += winding_lengths[j];
+        }
+        for (int j = 0; j < flatCount; ++j) {
+            windings[j].x = floorf(windings[j].x * params->pixelScale + 0.5f);
+            windings[j].y = floorf(windings[j].y * params->pixelScale + 0.5f);
+        }
+    }
+    for (int j = 0, source = 0; j < winding_count; ++j) {
+        if (params->simplify > 0) {
+            // 在写入文件的 short 坐标上简化，误差界对输出结果成立；简化后的轮廓依次前移
+            stbtt__point *contour = &windings[pointCount];
+            memmove(contour, &windings[source], winding_lengths[j] * sizeof(stbtt__point));
+            for (int k = 0; k < winding_lengths[j]; ++k) {
+                contour[k].x = (short)contour[k].x;
+                contour[k].y = (short)contour[k].y;
+            }
+            source += winding_lengths[j];
+            winding_lengths[j] = simplifyContour(contour, winding_lengths[j], params->simplify);
+        }
+        pointCount += winding_lengths[j];
+    }
+    double flattened = times ? getTimeMs() : 0;
+
+    if (params->outlineFormat == OUTLINE_FORMAT_EDGES) {
+        int result = writeEdgeTable(windings, winding_lengths, winding_count, out);
+        free(windings);
+        free(winding_lengths);
+        stbtt_FreeShape(font, stbVertex);
+        if (times) {
+            times->ms[PHASE_SHAPE] += shaped - start;
+            times->ms[PHASE_FLATTEN] += flattened - shaped;
+            times->ms[PHASE_SERIALIZE] += getTimeMs() - flattened;
+        }
+        return result == 0 && !out->error ? 0 : -1;
+    }
+
+    // 一次性预留整条记录所需空间，避免逐点扩容
+    outputBufferReserve(out, 1 + winding_count + pointCount * 2 * sizeof(short));
+
+    uint8_t winding_count_u8 = (uint8_t)winding_count;
+    outputBufferWrite(out, &winding_count_u8, sizeof(uint8_t));
+
+    for (int j = 0; j < winding_count; ++j) {
+        uint8_t winding_length_u8 = (uint8_t)winding_lengths[j];
+        outputBufferWrite(out, &winding_length_u8, sizeof(uint8_t));
+    }
+
+    if (params->outlineFormat == OUTLINE_FORMAT_DELTA) {
+        // 差值基于截断后的 short 坐标，解码结果与原始格式逐点相同；每个分量最多 3 字节
+        outputBufferReserve(out, (size_t)pointCount * 2 * 3);
+        short previous[2] = { 0, 0 };
+        for (int j = 0; j < pointCount; ++j) {
+            short point[2] = { (short)windings[j].x, (short)windings[j].y };
+            outputBufferWriteVarint(out, zigzagEncode(point[0] - previous[0]));
+            outputBufferWriteVarint(out, zigzagEncode(point[1] - previous[1]));
+            previous[0] = point[0];
+            previous[1] = point[1];
+        }
+    } else if (params->outlineFormat == OUTLINE_FORMAT_QUANTIZED) {
+        // 包围盒由 stbtt_GetGlyphBitmapBox 得到，y 向下；轮廓点的 y 向上，范围为 [-y1, -y0]
+        int box[4] = { x0, x1 - x0, -y1, y1 - y0 };
+        writeQuantizedPoints(windings, pointCount, box, params->quantBits, out, quantError);
+    } else {
+        for (int j = 0; j < pointCount; ++j) {
+            short point[2] = { (short)windings[j].x, (short)windings[j].y };
+            outputBufferWrite(out, point, sizeof(point));
+        }
+    }
+
+    free(windings);
+    free(winding_lengths);
+    stbtt_FreeShape(font, stbVertex);
+
+    if (times) {
+        times->ms[PHASE_SHAPE] += shaped - start;
+        times->ms[PHASE_FLATTEN] += flattened - shaped;
+        times->ms[PHASE_SERIALIZE] += getTimeMs() - flattened;
+    }
+    return out->error ? -1 : 0;
+}
+
+// 线程封装：Windows 下使用 CreateThread，其余平台使用 pthread
+typedef void (*ThreadFunc)(void *arg);
+
+typedef struct {
+    ThreadFunc func;
+    void *arg;
+} ThreadStart;
+
+#ifdef _WIN32
+typedef HANDLE ThreadHandle;
+
+static DWORD WINAPI threadTrampoline(LPVOID param) {
+    ThreadStart start = *(ThreadStart *)param;
+    free(param);
+    start.func(start.arg);
+    return 0;
+}
+#else
+typedef pthread_t ThreadHandle;
+
+static void *threadTrampoline(void *param) {
+    ThreadStart start = *(ThreadStart *)param;
+    free(param);
+    start.func(start.arg);
+    return NULL;
+}
+#endif
+
+int threadCreate(ThreadHandle *thread, ThreadFunc func, void *arg) {
+    ThreadStart *start = (ThreadStart *)malloc(sizeof(ThreadStart));
+    if (!start) return -1;
+    start->func = func;
+    start->arg = arg;
+
+#ifdef _WIN32
+    *thread = CreateThread(NULL, 0, threadTrampoline, start, 0, NULL);
+    if (*thread == NULL) {
+        free(start);
+        return -1;
+    }
+#else
+    if (pthread_create(thread, NULL, threadTrampoline, start) != 0) {
+        free(start);
+        return -1;
+    }
+#endif
+    return 0;
+}
+
+void threadJoin(ThreadHandle thread) {
+#ifdef _WIN32
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+}
+
+int getCpuCount(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+#endif
+}
+
+// 互斥锁封装
+#ifdef _WIN32
+typedef CRITICAL_SECTION Mutex;
+#else
+typedef pthread_mutex_t Mutex;
+#endif
+
+void mutexInit(Mutex *mutex) {
+#ifdef _WIN32
+    InitializeCriticalSection(mutex);
+#else
+    pthread_mutex_init(mutex, NULL);
+#endif
+}
+
+void mutexLock(Mutex *mutex) {
+#ifdef _WIN32
+    EnterCriticalSection(mutex);
+#else
+    pthread_mutex_lock(mutex);
+#endif
+}
+
+void mutexUnlock(Mutex *mutex) {
+#ifdef _WIN32
+    LeaveCriticalSection(mutex);
+#else
+    pthread_mutex_unlock(mutex);
+#endif
+}
+
+void mutexDestroy(Mutex *mutex) {
+#ifdef _WIN32
+    DeleteCriticalSection(mutex);
+#else
+    pthread_mutex_destroy(mutex);
+#endif
+}
+
+// 只读文件映射：优先使用 mmap / MapViewOfFile，失败时退化为一次性读入内存
+typedef struct {
+    const unsigned char *data;
+    size_t size;
+    int isMapped;  // 1 表示映射，0 表示退化为 malloc + fread
+#ifdef _WIN32
+    HANDLE fileHandle;
+    HANDLE mappingHandle;
+#endif
+} MappedFile;
+
+static int readWholeFile(const char *path, MappedFile *mapped) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Error opening file %s!\n", path);
+        return -1;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size <= 0) {
+        fprintf(stderr, "File %s is empty!\n", path);
+        fclose(file);
+        return -1;
+    }
+
+    unsigned char *buffer = (unsigned char *)malloc(size);
+    if (!buffer) {
+        fprintf(stderr, "Memory allocation error!\n");
+        fclose(file);
+        return -1;
+    }
+
+    if (fread(buffer, 1, size, file) != (size_t)size) {
+        fprintf(stderr, "Error reading file %s!\n", path);
+        free(buffer);
+        fclose(file);
+        return -1;
+    }
+    fclose(file);
+
+    mapped->data = buffer;
+    mapped->size = (size_t)size;
+    mapped->isMapped = 0;
+    return 0;
+}
+
+int mapFileReadOnly(const char *path, MappedFile *mapped) {
+    memset(mapped, 0, sizeof(MappedFile));
+
+#ifdef _WIN32
+    HANDLE fileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (fileHandle != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER fileSize;
+        if (GetFileSizeEx(fileHandle, &fileSize) && fileSize.QuadPart > 0) {
+            HANDLE mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (mappingHandle) {
+                const void *view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+                if (view) {
+                    mapped->data = (const unsigned char *)view;
+                    mapped->size = (size_t)fileSize.QuadPart;
+                    mapped->isMapped = 1;
+                    mapped->fileHandle = fileHandle;
+                    mapped->mappingHandle = mappingHandle;
+                    return 0;
+                }
+                CloseHandle(mappingHandle);
+            }
+        }
+        CloseHandle(fileHandle);
+    }
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void *view = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view != MAP_FAILED) {
+                close(fd);  // 映射建立后即可关闭文件描述符
+                mapped->data = (const unsigned char *)view;
+                mapped->size = (size_t)st.st_size;
+                mapped->isMapped = 1;
+                return 0;
+            }
+        }
+        close(fd);
+    }
+#endif
+
+    return readWholeFile(path, mapped);
+}
+
+void unmapFile(MappedFile *mapped) {
+    if (!mapped->data) return;
+
+    if (mapped->isMapped) {
+#ifdef _WIN32
+        UnmapViewOfFile(mapped->data);
+        CloseHandle(mapped->mappingHandle);
+        CloseHandle(mapped->fileHandle);
+#else
+        munmap((void *)mapped->data, mapped->size);
+#endif
+    } else {
+        free((void *)mapped->data);
+    }
+    memset(mapped, 0, sizeof(MappedFile));
+}
+
+// 以 func(arg[i]) 的形式并行执行 count 个任务，最多同时开 count 个线程；
+// 线程创建失败时退化为在当前线程中执行，保证结果不受影响
+void runParallel(ThreadFunc func, void *args, size_t argSize, int count) {
+    if (count <= 1) {
+        if (count == 1) func(args);
+        return;
+    }
+
+    ThreadHandle *threads = (ThreadHandle *)malloc(count * sizeof(ThreadHandle));
+    int *started = (int *)calloc(count, sizeof(int));
+    if (!threads || !started) {
+        free(threads);
+        free(started);
+        for (int i = 0; i < count; ++i) func((char *)args + i * argSize);
+        return;
+    }
+
+    // 第 0 个任务留在当前线程执行
+    for (int i = 1; i < count; ++i) {
+        started[i] = threadCreate(&threads[i], func, (char *)args + i * argSize) == 0;
+    }
+    func(args);
+    for (int i = 1; i < count; ++i) {
+        if (started[i]) {
+            threadJoin(threads[i]);
+        } else {
+            func((char *)args + i * argSize);
+        }
+    }
+
+    free(threads);
+    free(started);
+}
+
+void initGenerateOptions(GenerateOptions *options) {
+    options->threadCount = 1;
+    options->glyphCache = NULL;
+    options->fontHash = 0;
+    options->glyphLookup = NULL;
+    options->dedupGlyphs = 1;
+    options->missingGlyphs = MISSING_GLYPH_EMPTY;
+    options->profile = NULL;
+    options->checksum = 0;
+    options->simplifyTolerance = 0;
+    options->quantBits = QUANT_BITS_DEFAULT;
+    options->fixedPointBits = 0;
+    options->outlineFormat = OUTLINE_FORMAT_RAW;
+    options->indexLayout = INDEX_LAYOUT_INTERLEAVED;
+    options->recordFontHash = 0;
+}
+
+// 磁盘字形缓存：以 (TTF 内容哈希, 字形索引, 提取参数哈希) 为键，
+// 每个键对应目录下的一个文件，内容为已经序列化好的字形记录
+struct GlyphCache {
+    char *directory;
+    uint64_t maxBytes;  // 缓存目录大小上限，0 表示不限制；关闭时按最近使用时间淘汰
+    Mutex lock;
+    long hits;
+    long misses;
+    long stores;
+};
+
+// 缓存文件：magic、记录长度、字体哈希、参数哈希，之后是字形记录。
+// 文件名只是查找用的索引，加载时仍然比较完整的 64 位哈希
+#define GLYPH_CACHE_MAGIC 0x32524347u  // "GCR2"
+#define GLYPH_CACHE_MAX_RECORD (1u << 20)  // 单条记录的长度上限，超出视为损坏
+#define GLYPH_CACHE_MIN_RECORD (sizeof(short) * 5 + 1)  // 记录至少包含包围盒、advance 和轮廓数，更短视为损坏
+
+int glyphCacheOpen(GlyphCache *cache, const char *directory, uint64_t maxBytes) {
+    memset(cache, 0, sizeof(GlyphCache));
+#ifdef _WIN32
+    if (!CreateDirectoryA(directory, NULL) && GetLastError() != ERROR_ALREADY_EXISTS) {
+#else
+    if (mkdir(directory, 0755) != 0 && errno != EEXIST) {
+#endif
+        fprintf(stderr, "Error creating cache directory %s!\n", directory);
+        return -1;
+    }
+
+    cache->directory = strdup(directory);
+    if (!cache->directory) return -1;
+    cache->maxBytes = maxBytes;
+    mutexInit(&cache->lock);
+    return 0;
+}
+
+static void glyphCachePath(const GlyphCache *cache, uint64_t fontHash, int glyphIndex, uint64_t paramsHash, char *path, size_t pathSize) {
+    snprintf(path, pathSize, "%s/%016llx-%05x-%016llx.glyph", cache->directory,
+             (unsigned long long)fontHash, glyphIndex, (unsigned long long)paramsHash);
+}
+
+// 命中时把记录追加到 out 并返回 1，未命中返回 0
+int glyphCacheLoad(GlyphCache *cache, uint64_t fontHash, int glyphIndex, uint64_t paramsHash, OutputBuffer *out) {
+    char path[1024];
+    glyphCachePath(cache, fontHash, glyphIndex, paramsHash, path, sizeof(path));
+
+    int hit = 0;
+    FILE *file = fopen(path, "rb");
+    if (file) {
+        uint32_t header[2];
+        uint64_t keys[2];
+        if (fread(header, sizeof(uint32_t), 2, file) == 2 && header[0] == GLYPH_CACHE_MAGIC &&
+            header[1] >= GLYPH_CACHE_MIN_RECORD && header[1] <= GLYPH_CACHE_MAX_RECORD &&
+            fread(keys, sizeof(uint64_t), 2, file) == 2 && keys[0] == fontHash && keys[1] == paramsHash &&
+            outputBufferReserve(out, header[1]) == 0 &&
+            fread(out->data + out->size, 1, header[1], file) == header[1]) {
+            out->size += header[1];
+            hit = 1;
+        }
+        fclose(file);
+    }
+
+    if (hit) {
+        // 更新修改时间，淘汰时按最近使用排序
+#ifdef _WIN32
+        _utime(path, NULL);
+#else
+        utime(path, NULL);
+#endif
+    }
+
+    mutexLock(&cache->lock);
+    if (hit) {
+        cache->hits++;
+    } else {
+        cache->misses++;
+    }
+    mutexUnlock(&cache->lock);
+    return hit;
+}
+
+// 先写临时文件再改名，多个线程或进程同时写同一个键时读者不会看到半条记录
+void glyphCacheStore(GlyphCache *cache, uint64_t fontHash, int glyphIndex, uint64_t paramsHash, const uint8_t *record, uint32_t length) {
+    char path[1024];
+    char tempPath[1100];
+    if (length < GLYPH_CACHE_MIN_RECORD || length > GLYPH_CACHE_MAX_RECORD) return;  // 加载时会被拒绝，不必写入
+    glyphCachePath(cache, fontHash, glyphIndex, paramsHash, path, sizeof(path));
+
+    mutexLock(&cache->lock);
+    long serial = cache->stores++;
+    mutexUnlock(&cache->lock);
+#ifdef _WIN32
+    snprintf(tempPath, sizeof(tempPath), "%s.%lu.%ld.tmp", path, (unsigned long)GetCurrentProcessId(), serial);
+#else
+    snprintf(tempPath, sizeof(tempPath), "%s.%ld.%ld.tmp", path, (long)getpid(), serial);
+#endif
+
+    FILE *file = fopen(tempPath, "wb");
+    if (!file) return;
+
+    uint32_t header[2] = { GLYPH_CACHE_MAGIC, length };
+    uint64_t keys[2] = { fontHash, paramsHash };
+    int ok = fwrite(header, sizeof(uint32_t), 2, file) == 2 && fwrite(keys, sizeof(uint64_t), 2, file) == 2 &&
+             fwrite(record, 1, length, file) == length;
+    ok = fclose(file) == 0 && ok;
+
+    if (!ok || rename(tempPath, path) != 0) {
+        remove(tempPath);
+    }
+}
+
+typedef struct {
+    char *name;
+    uint64_t size;
+    int64_t lastUsed;
+} GlyphCacheEntry;
+
+static int compareGlyphCacheEntry(const void *a, const void *b) {
+    int64_t x = ((const GlyphCacheEntry *)a)->lastUsed;
+    int64_t y = ((const GlyphCacheEntry *)b)->lastUsed;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+static int appendGlyphCacheEntry(GlyphCacheEntry **entries, int *count, int *capacity, const char *name, uint64_t size, int64_t lastUsed) {
+    if (*count == *capacity) {
+        int newCapacity = *capacity ? *capacity * 2 : 256;
+        GlyphCacheEntry *newEntries = (GlyphCacheEntry *)realloc(*entries, newCapacity * sizeof(GlyphCacheEntry));
+        if (!newEntries) return -1;
+        *entries = newEntries;
+        *capacity = newCapacity;
+    }
+    (*entries)[*count].name = strdup(name);
+    (*entries)[*count].size = size;
+    (*entries)[*count].lastUsed = lastUsed;
+    if (!(*entries)[*count].name) return -1;
+    (*count)++;
+    return 0;
+}
+
+// 超过大小上限时，从最久未使用的记录开始删除，直到低于上限
+void glyphCacheEvict(GlyphCache *cache) {
+    if (cache->maxBytes == 0) return;
+
+    GlyphCacheEntry *entries = NULL;
+    int count = 0;
+    int capacity = 0;
+    uint64_t totalBytes = 0;
+    char path[1024];
+
+#ifdef _WIN32
+    WIN32_FIND_DATAA findData;
+    snprintf(path, sizeof(path), "%s/*.glyph", cache->directory);
+    HANDLE find = FindFirstFileA(path, &findData);
+    if (find != INVALID_HANDLE_VALUE) {
+        do {
+            uint64_t size = ((uint64_t)findData.nFileSizeHigh << 32) | findData.nFileSizeLow;
+            int64_t lastUsed = ((int64_t)findData.ftLastWriteTime.dwHighDateTime << 32) | findData.ftLastWriteTime.dwLowDateTime;
+            if (appendGlyphCacheEntry(&entries, &count, &capacity, findData.cFileName, size, lastUsed) != 0) break;
+            totalBytes += size;
+        } while (FindNextFileA(find, &findData));
+        FindClose(find);
+    }
+#else
+    DIR *dir = opendir(cache->directory);
+    if (dir) {
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != NULL) {
+            size_t nameLength = strlen(entry->d_name);
+            if (nameLength < 6 || strcmp(entry->d_name + nameLength - 6, ".glyph") != 0) continue;
+
+            struct stat st;
+            snprintf(path, sizeof(path), "%s/%s", cache->directory, entry->d_name);
+            if (stat(path, &st) != 0) continue;
+            if (appendGlyphCacheEntry(&entries, &count, &capacity, entry->d_name, (uint64_t)st.st_size, (int64_t)st.st_mtime) != 0) break;
+            totalBytes += (uint64_t)st.st_size;
+        }
+        closedir(dir);
+    }
+#endif
+
+    if (totalBytes > cache->maxBytes) {
+        qsort(entries, count, sizeof(GlyphCacheEntry), compareGlyphCacheEntry);
+        int evicted = 0;
+        for (int i = 0; i < count && totalBytes > cache->maxBytes; ++i) {
+            snprintf(path, sizeof(path), "%s/%s", cache->directory, entries[i].name);
+            if (remove(path) == 0) {
+                totalBytes -= entries[i].size;
+                evicted++;
+            }
+        }
+        printf("[cache] evicted %d entries, %llu bytes remain\n", evicted, (unsigned long long)totalBytes);
+    }
+
+    for (int i = 0; i < count; ++i) {
+        free(entries[i].name);
+    }
+    free(entries);
+}
+
+void glyphCacheClose(GlyphCache *cache) {
+    if (!cache->directory) return;
+
+    printf("[cache] %ld hits, %ld misses\n", cache->hits, cache->misses);
+    glyphCacheEvict(cache);
+
+    mutexDestroy(&cache->lock);
+    free(cache->directory);
+    cache->directory = NULL;
+}
+
+// 已有的字形记录，增量更新时按字节原样复用
+typedef struct {
+    const uint8_t *data;
+    uint32_t length;
+} GlyphRecordRef;
+
+// 生成过程中的字形计数
+typedef struct {
+    int reused;     // 复用已有记录
+    int extracted;  // 重新提取（含缓存命中）
+    int cached;     // 其中由磁盘缓存命中
+    int missing;    // 字体中不存在
+    int duplicates;       // 与已写出的记录相同、共用偏移的字形
+    uint32_t savedBytes;  // 去重省下的字节数
+    float quantError;     // 量化格式的最大坐标误差：提取过程中为字体单位，buildBinFile 返回时换算为像素；只统计本次提取的字形
+} BuildCounts;
+
+// 字形记录的来源
+#define GLYPH_SOURCE_EXTRACTED 0
+#define GLYPH_SOURCE_CACHED    1
+#define GLYPH_SOURCE_REUSED    2
+#define GLYPH_SOURCE_MISSING   3
+
+static const char *const glyphSourceNames[] = { "extracted", "cached", "reused", "missing" };
+
+// 单个字形的统计
+typedef struct {
+    uint16_t codepoint;
+    uint16_t glyphIndex;
+    uint32_t bytes;      // 记录长度，缺失时为 0
+    uint32_t points;
+    uint8_t windings;
+    uint8_t source;      // GLYPH_SOURCE_*
+    uint8_t duplicate;   // 与之前的记录相同，未重复写入
+} GlyphStats;
+
+// 生成统计：GenerateOptions.profile 非空时由 buildBinFile 填写，
+// 各阶段耗时在多线程时是各线程之和
+struct GenerateProfile {
+    double phaseMs[PHASE_COUNT];
+    double wallMs;
+    BuildCounts counts;
+    uint32_t fileBytes;
+    uint32_t headerBytes;
+    uint32_t indexBytes;
+    GlyphStats *glyphs;  // 按码位升序
+    int glyphCount;
+};
+
+void freeGenerateProfile(GenerateProfile *profile) {
+    free(profile->glyphs);
+    memset(profile, 0, sizeof(GenerateProfile));
+}
+
+// 字形提取任务：每个线程处理 codepoints[begin, end)，字形数据写入自己独占的缓冲区，
+// 字体信息只读共享。合并时按分片顺序拼接，因此输出与单线程完全一致
+typedef struct {
+    const stbtt_fontinfo *font;
+    const uint16_t *codepoints;
+    const uint16_t *glyphIndices;  // 可为空：为空时查 lookup，lookup 也为空时逐个码位查询 cmap
+    const GlyphLookup *lookup;
+    int begin;
+    int end;
+    const GlyphParams *params;
+    GlyphCache *cache;       // 可为空
+    uint64_t fontHash;
+    uint64_t paramsHash;
+    const GlyphRecordRef *reuse;  // 非空时，reuse[i].data 不为空的字形直接复制已有记录
+    uint32_t *localOffsets;  // 共享数组，本任务只写 [begin, end) 区间：字形在 out 中的起始位置
+    GlyphStats *stats;       // 共享数组，可为空：非空时记录 [begin, end) 区间的字形统计和各阶段耗时
+    PhaseTimes times;
+    OutputBuffer out;
+    BuildCounts counts;
+    int result;
+} GlyphWorker;
+
+// 码位对应的字形，有码位→字形表时直接查表
+static int resolveGlyphIndex(const stbtt_fontinfo *font, const GlyphLookup *lookup, uint16_t codepoint) {
+    return lookup ? glyphLookupFind(lookup, codepoint) : stbtt_FindGlyphIndex(font, codepoint);
+}
+
+void extractGlyphRange(void *arg) {
+    GlyphWorker *worker = (GlyphWorker *)arg;
+    worker->result = 0;
+    memset(&worker->counts, 0, sizeof(BuildCounts));
+    memset(&worker->times, 0, sizeof(PhaseTimes));
+    PhaseTimes *times = worker->stats ? &worker->times : NULL;
+
+    for (int i = worker->begin; i < worker->end; ++i) {
+        worker->localOffsets[i] = (uint32_t)worker->out.size;
+
+        double start = times ? getTimeMs() : 0;
+        int glyphIndex = worker->glyphIndices ? worker->glyphIndices[i]
+                                              : resolveGlyphIndex(worker->font, worker->lookup, worker->codepoints[i]);
+        if (times) {
+            times->ms[PHASE_CMAP] += getTimeMs() - start;
+            worker->stats[i].codepoint = worker->codepoints[i];
+            worker->stats[i].glyphIndex = (uint16_t)glyphIndex;
+            worker->stats[i].source = GLYPH_SOURCE_EXTRACTED;
+        }
+        if (glyphIndex == 0) {
+            worker->counts.missing++;
+            if (times) worker->stats[i].source = GLYPH_SOURCE_MISSING;
+            continue;
+        }
+
+        if (worker->reuse && worker->reuse[i].data) {
+            outputBufferWrite(&worker->out, worker->reuse[i].data, worker->reuse[i].length);
+            worker->counts.reused++;
+            if (times) worker->stats[i].source = GLYPH_SOURCE_REUSED;
+            continue;
+        }
+
+        worker->counts.extracted++;
+        if (worker->cache) {
+            start = times ? getTimeMs() : 0;
+            int hit = glyphCacheLoad(worker->cache, worker->fontHash, glyphIndex, worker->paramsHash, &worker->out);
+            if (times) times->ms[PHASE_IO] += getTimeMs() - start;
+            if (hit) {
+                worker->counts.cached++;
+                if (times) worker->stats[i].source = GLYPH_SOURCE_CACHED;
+                continue;
+            }
+        }
+
+        size_t recordStart = worker->out.size;
+        if (serializeGlyph(worker->font, glyphIndex, worker->params, &worker->out, times, &worker->counts.quantError) != 0) {
+            worker->result = -1;
+            return;
+        }
+        if (worker->cache) {
+            start = times ? getTimeMs() : 0;
+            glyphCacheStore(worker->cache, worker->fontHash, glyphIndex, worker->paramsHash,
+                            worker->out.data + recordStart, (uint32_t)(worker->out.size - recordStart));
+            if (times) times->ms[PHASE_IO] += getTimeMs() - start;
+        }
+    }
+}
+
+// 从一条字形记录中取出长度、轮廓数和点数；边表格式没有轮廓，点数记为边数
+static void fillGlyphRecordStats(GlyphStats *stats, const uint8_t *record, uint32_t length, int outlineFormat) {
+    const uint32_t fixedLength = sizeof(short) * 5 + 1;
+    stats->bytes = length;
+    if (outlineFormat == OUTLINE_FORMAT_EDGES) {
+        uint16_t edgeCount = 0;
+        if (length >= fixedLength + 1) memcpy(&edgeCount, record + fixedLength - 1, sizeof(uint16_t));
+        stats->windings = 0;
+        stats->points = edgeCount;
+        return;
+    }
+    stats->windings = length >= fixedLength ? record[fixedLength - 1] : 0;
+    stats->points = 0;
+    for (int j = 0; j < stats->windings && fixedLength + j < length; ++j) {
+        stats->points += record[fixedLength + j];
+    }
+}
+
+// 字形记录去重表：开放寻址，按记录内容哈希，值为记录在输出中的偏移
+typedef struct {
+    uint64_t *hashes;
+    uint32_t *offsets;
+    uint32_t *lengths;  // 为 0 表示空槽，字形记录至少 11 字节
+    uint32_t mask;
+} RecordDedupTable;
+
+static int recordDedupInit(RecordDedupTable *table, int count) {
+    uint32_t capacity = 16;
+    while (capacity < (uint32_t)count * 2) capacity <<= 1;
+    table->hashes = (uint64_t *)malloc(capacity * sizeof(uint64_t));
+    table->offsets = (uint32_t *)malloc(capacity * sizeof(uint32_t));
+    table->lengths = (uint32_t *)calloc(capacity, sizeof(uint32_t));
+    table->mask = capacity - 1;
+    if (!table->hashes || !table->offsets || !table->lengths) {
+        free(table->hashes);
+        free(table->offsets);
+        free(table->lengths);
+        memset(table, 0, sizeof(RecordDedupTable));
+        return -1;
+    }
+    return 0;
+}
+
+static void recordDedupFree(RecordDedupTable *table) {
+    free(table->hashes);
+    free(table->offsets);
+    free(table->lengths);
+    memset(table, 0, sizeof(RecordDedupTable));
+}
+
+// 把一条字形记录写入 out 并返回其偏移；启用去重且已有内容相同的记录时不再写入，直接返回已有偏移
+static uint32_t writeGlyphRecord(RecordDedupTable *table, OutputBuffer *out, const uint8_t *record, uint32_t length, BuildCounts *counts) {
+    if (!table->lengths) {
+        uint32_t offset = (uint32_t)out->size;
+        outputBufferWrite(out, record, length);
+        return offset;
+    }
+
+    uint64_t hash = hashBytes(record, length, 0);
+    uint32_t slot = (uint32_t)hash & table->mask;
+    while (table->lengths[slot]) {
+        if (table->hashes[slot] == hash && table->lengths[slot] == length &&
+            memcmp(out->data + table->offsets[slot], record, length) == 0) {
+            counts->duplicates++;
+            counts->savedBytes += length;
+            return table->offsets[slot];
+        }
+        slot = (slot + 1) & table->mask;
+    }
+
+    uint32_t offset = (uint32_t)out->size;
+    table->hashes[slot] = hash;
+    table->offsets[slot] = offset;
+    table->lengths[slot] = length;
+    outputBufferWrite(out, record, length);
+    return offset;
+}
+
+int generateBinFile(const char *ttfPath, const char *binPath, const char *text, FontSet *fontSet) {
+    return generateBinFileEx(ttfPath, binPath, text, fontSet, NULL);
+}
+
+int generateBinFileEx(const char *ttfPath, const char *binPath, const char *text, FontSet *fontSet, const GenerateOptions *options) {
+    MappedFile ttfFile;
+    if (mapFileReadOnly(ttfPath, &ttfFile) != 0) {
+        fprintf(stderr, "Error opening TTF file!\n");
+        return -1;
+    }
+
+    int result = generateBinFileFromMemory(ttfFile.data, ttfFile.size, binPath, text, fontSet, options);
+    unmapFile(&ttfFile);
+    return result;
+}
+
+// 从内存中的 TTF 数据生成 bin 文件，ttfData 在调用期间必须保持有效
+int generateBinFileFromMemory(const unsigned char *ttfData, size_t ttfSize, const char *binPath, const char *text, FontSet *fontSet, const GenerateOptions *options) {
+    GenerateOptions fontOptions;
+    if (options) {
+        fontOptions = *options;
+    } else {
+        initGenerateOptions(&fontOptions);
+    }
+    if ((fontOptions.glyphCache || fontOptions.recordFontHash) && !fontOptions.fontHash) {
+        fontOptions.fontHash = hashBytes(ttfData, ttfSize, 0);
+    }
+
+    stbtt_fontinfo font;
+    int fontOffset = ttfSize >= 12 ? stbtt_GetFontOffsetForIndex(ttfData, 0) : -1;
+    if (fontOffset < 0 || !stbtt_InitFont(&font, ttfData, fontOffset)) {
+        fprintf(stderr, "Failed to initialize font!\n");
+        return -1;
+    }
+
+    // 调用方给出的表属于其他字体对象，这里按新解析的字体重建
+    GlyphLookup lookup;
+    if (glyphLookupBuild(&lookup, &font) != 0) {
+        return -1;
+    }
+    fontOptions.glyphLookup = &lookup;
+
+    int result = generateBinFileFromFont(&font, binPath, text, fontSet, &fontOptions);
+    glyphLookupFree(&lookup);
+    return result;
+}
+
+// 从已解析的字体生成 bin 文件；font 只读，可被多个任务同时共享
+// 取字体名，无效时使用默认字体名 "font"
+const char *getFontName(const stbtt_fontinfo *font, int *length) {
+    const char* nameString = stbtt_GetFontNameString(font, length, 1, 0, 0, 1);
+
+    // 检查 nameString 及 nameStringLength。如果无效，则使用默认字体名 "font"
+    if (nameString == NULL || *length <= 0) {
+        nameString = "font";
+        *length = strlen(nameString);
+    }
+    return nameString;
+}
+
+int buildBinFile(const stbtt_fontinfo *font, const uint16_t *codepoints, const uint16_t *glyphIndices, int count, const GlyphRecordRef *reuse,
+                 FontSet *fontSet, const GenerateOptions *options, OutputBuffer *out, BuildCounts *counts);
+
+// MISSING_GLYPH_OMIT：先解析全部码位的字形，去掉字体中不存在的码位后按正常流程生成
+static int buildBinFileOmitMissing(const stbtt_fontinfo *font, const uint16_t *codepoints, const uint16_t *glyphIndices, int count,
+                                   const GlyphRecordRef *reuse, FontSet *fontSet, const GenerateOptions *options,
+                                   OutputBuffer *out, BuildCounts *counts) {
+    uint16_t *keptCodepoints = (uint16_t *)malloc((count > 0 ? count : 1) * sizeof(uint16_t));
+    uint16_t *keptGlyphs = (uint16_t *)malloc((count > 0 ? count : 1) * sizeof(uint16_t));
+    GlyphRecordRef *keptReuse = reuse ? (GlyphRecordRef *)malloc((count > 0 ? count : 1) * sizeof(GlyphRecordRef)) : NULL;
+    if (!keptCodepoints || !keptGlyphs || (reuse && !keptReuse)) {
+        fprintf(stderr, "Memory allocation error for glyph list!\n");
+        free(keptCodepoints);
+        free(keptGlyphs);
+        free(keptReuse);
+        return -1;
+    }
+
+    int kept = 0;
+    for (int i = 0; i < count; ++i) {
+        int glyphIndex = glyphIndices ? glyphIndices[i] : resolveGlyphIndex(font, options->glyphLookup, codepoints[i]);
+        if (glyphIndex == 0) continue;
+        keptCodepoints[kept] = codepoints[i];
+        keptGlyphs[kept] = (uint16_t)glyphIndex;
+        if (keptReuse) keptReuse[kept] = reuse[i];
+        kept++;
+    }
+
+    GenerateOptions keptOptions = *options;
+    keptOptions.missingGlyphs = MISSING_GLYPH_EMPTY;  // 剩下的码位都有字形
+    int result = buildBinFile(font, keptCodepoints, keptGlyphs, kept, keptReuse, fontSet, &keptOptions, out, counts);
+    if (counts) counts->missing = count - kept;
+    if (options->profile) options->profile->counts.missing = count - kept;
+
+    free(keptCodepoints);
+    free(keptGlyphs);
+    free(keptReuse);
+    return result;
+}
+
+// 实际写入文件的定点小数位数：边表格式总是使用定点像素坐标
+static int effectiveFixedPointBits(const GenerateOptions *options) {
+    if (options->outlineFormat == OUTLINE_FORMAT_EDGES && !options->fixedPointBits) return EDGE_TABLE_FIXED_POINT_BITS;
+    return options->fixedPointBits;
+}
+
+// 实际生效的简化容差：曲线格式在渲染时才展平，不做简化
+static float effectiveSimplifyTolerance(const GenerateOptions *options) {
+    if (options->outlineFormat == OUTLINE_FORMAT_CURVES || options->simplifyTolerance <= 0) return 0;
+    return options->simplifyTolerance;
+}
+
+// 由排好序、去重后的码位列表在 out 中拼装完整的 bin 文件。
+// glyphIndices 非空时为每个码位对应的字形（例如遍历 cmap 得到），不再逐个查询；
+// reuse 为空时全部重新提取；否则 reuse[i].data 非空的字形直接复用已有记录。
+// 字体中不存在的码位按 options->missingGlyphs 处理。
+// 成功时 out 由调用方释放，counts 可为空
+int buildBinFile(const stbtt_fontinfo *font, const uint16_t *codepoints, const uint16_t *glyphIndices, int count, const GlyphRecordRef *reuse,
+                 FontSet *fontSet, const GenerateOptions *options, OutputBuffer *out, BuildCounts *counts) {
+    GenerateOptions defaultOptions;
+    if (!options) {
+        initGenerateOptions(&defaultOptions);
+        options = &defaultOptions;
+    }
+
+    // 边表只有定点像素坐标一种形式，未指定小数位数时使用默认值
+    GenerateOptions edgeOptions;
+    if (options->fixedPointBits != effectiveFixedPointBits(options)) {
+        edgeOptions = *options;
+        edgeOptions.fixedPointBits = effectiveFixedPointBits(options);
+        options = &edgeOptions;
+    }
+
+    outputBufferInit(out, 0);
+    if (options->outlineFormat == OUTLINE_FORMAT_QUANTIZED &&
+        (options->quantBits < QUANT_BITS_MIN || options->quantBits > QUANT_BITS_MAX)) {
+        fprintf(stderr, "Quantization bits must be between %d and %d!\n", QUANT_BITS_MIN, QUANT_BITS_MAX);
+        return -1;
+    }
+    if (options->fixedPointBits &&
+        (options->fixedPointBits < 0 || options->fixedPointBits > FIXED_POINT_BITS_MAX ||
+         ((int)(uint8_t)fontSet->fontSize << options->fixedPointBits) > FIXED_POINT_LIMIT)) {
+        fprintf(stderr, "Fixed-point pixel coordinates with %d fraction bits do not fit %dpx glyphs in 16 bits!\n",
+                options->fixedPointBits, (uint8_t)fontSet->fontSize);
+        return -1;
+    }
+    if (options->indexLayout < INDEX_LAYOUT_INTERLEAVED || options->indexLayout > INDEX_LAYOUT_PAGED) {
+        fprintf(stderr, "Unknown index layout %d!\n", options->indexLayout);
+        return -1;
+    }
+    if (options->fixedPointBits && options->outlineFormat == OUTLINE_FORMAT_CURVES) {
+        fprintf(stderr, "Fixed-point pixel coordinates do not apply to the curves outline format!\n");
+        return -1;
+    }
+    if (options->missingGlyphs == MISSING_GLYPH_OMIT) {
+        return buildBinFileOmitMissing(font, codepoints, glyphIndices, count, reuse, fontSet, options, out, counts);
+    }
+    fontSet->indexLayout = (uint8_t)options->indexLayout;
+    int segmentCount = fontSet->indexLayout == INDEX_LAYOUT_RANGES ? countCodepointRuns(codepoints, count) : 0;
+    fontSet->indexAreaSize = getIndexAreaSize(fontSet->indexLayout, count, segmentCount);
+
+    // 统计数组申请失败时只记录耗时
+    double buildStart = getTimeMs();
+    GenerateProfile *profile = options->profile;
+    GlyphStats *stats = NULL;
+    if (profile) {
+        freeGenerateProfile(profile);
+        stats = (GlyphStats *)calloc(count > 0 ? count : 1, sizeof(GlyphStats));
+    }
+
+    int nameStringLength;
+    const char* nameString = getFontName(font, &nameStringLength);
+
+    fontSet->fontName = (char *)malloc(nameStringLength + 1);
+    if (!fontSet->fontName) {
+        fprintf(stderr, "Memory allocation error for font name!\n");
+        return -1;
+    }
+    strncpy(fontSet->fontName, nameString, nameStringLength);
+    fontSet->fontName[nameStringLength] = '\0';
+    fontSet->fontNameLength = (uint8_t)nameStringLength;
+
+    int ascent, descent, lineGap;
+    stbtt_GetFontVMetrics(font, &ascent, &descent, &lineGap);
+    float scale = stbtt_ScaleForPixelHeight(font, fontSet->fontSize);
+
+    // 定点像素坐标：度量和字形使用同一单位，getBinScaleForPixelHeight 的换算仍然成立
+    float pixelScale = options->fixedPointBits ? scale * (float)(1 << options->fixedPointBits) : 0;
+    if (pixelScale > 0) {
+        ascent = (int)floorf(ascent * pixelScale + 0.5f);
+        descent = (int)floorf(descent * pixelScale + 0.5f);
+        lineGap = (int)floorf(lineGap * pixelScale + 0.5f);
+    }
+    fontSet->ascent = (short)ascent;
+    fontSet->descent = (short)descent;
+    fontSet->lineGap = (short)lineGap;
+
+    fontSet->rsvd = (options->checksum ? FONTSET_FLAG_CHECKSUM : 0) | (options->outlineFormat & OUTLINE_FORMAT_MASK);
+    fontSet->quantBits = options->outlineFormat == OUTLINE_FORMAT_QUANTIZED ? (uint8_t)options->quantBits : 0;
+    fontSet->fixedPointBits = (uint8_t)options->fixedPointBits;
+    fontSet->fontScale = pixelScale > 0 ? scale : 0;
+    fontSet->fontHash = options->recordFontHash ? options->fontHash : 0;
+    fontSet->simplifyTolerance = effectiveSimplifyTolerance(options);
+    int headerLength = calculateFontSetLength(fontSet) + (nameStringLength - fontSet->fontNameLength);
+    if (headerLength > FONTSET_LENGTH_MAX) {
+        fprintf(stderr, "Font set header is %d bytes, longer than %d!\n", headerLength, FONTSET_LENGTH_MAX);
+        free(fontSet->fontName);
+        fontSet->fontName = NULL;
+        return -1;
+    }
+    fontSet->length = (char)headerLength;
+    int extended = fontSet->rsvd != 0 || options->missingGlyphs == MISSING_GLYPH_NOTDEF ||
+                   headerLength > FONTSET_FIXED_LENGTH + fontSet->fontNameLength;
+    memcpy(fontSet->version, extended ? FONTSET_VERSION_EXTENDED : FONTSET_VERSION_BASE, 4);
+
+    // 预估容量：头部 + 索引区 + 每个字形约 256 字节
+    outputBufferReserve(out, (size_t)fontSet->length + fontSet->indexAreaSize + (size_t)count * 256);
+
+    serializeFontSetHeader(fontSet, out);
+
+    // 索引区先写入 unicode 和地址占位符，字形数据写完后原地回填
+    size_t indexStartOffset = out->size;
+    if (fontSet->indexLayout == INDEX_LAYOUT_SPLIT) {
+        uint32_t placeholder = 0;
+        outputBufferWrite(out, codepoints, (size_t)count * sizeof(uint16_t));
+        outputBufferWrite(out, &placeholder, getSplitIndexKeyBytes(count) - (size_t)count * sizeof(uint16_t));
+        for (int i = 0; i < count; ++i) {
+            outputBufferWrite(out, &placeholder, sizeof(uint32_t));
+        }
+    } else if (fontSet->indexLayout == INDEX_LAYOUT_PAGED) {
+        // 码位已升序排列，同一高字节的码位连续，各页依次对应
+        IndexPage pages[INDEX_PAGE_COUNT];
+        memset(pages, 0, sizeof(pages));
+        for (int i = count - 1; i >= 0; --i) {
+            pages[codepoints[i] >> 8].start = (uint16_t)i;
+            pages[codepoints[i] >> 8].count++;
+        }
+        for (int page = 1; page < INDEX_PAGE_COUNT; ++page) {
+            if (pages[page].count == 0) pages[page].start = (uint16_t)(pages[page - 1].start + pages[page - 1].count);
+        }
+        outputBufferWrite(out, pages, sizeof(pages));
+        for (int i = 0; i < count; ++i) {
+            uint8_t low = (uint8_t)codepoints[i];
+            outputBufferWrite(out, &low, sizeof(uint8_t));
+        }
+        uint32_t placeholder = 0;
+        outputBufferWrite(out, &placeholder, getPagedIndexHeaderBytes(count) - sizeof(pages) - (size_t)count);
+        for (int i = 0; i < count; ++i) {
+            outputBufferWrite(out, &placeholder, sizeof(uint32_t));
+        }
+    } else if (fontSet->indexLayout == INDEX_LAYOUT_RANGES) {
+        uint32_t segments = (uint32_t)segmentCount;
+        outputBufferWrite(out, &segments, sizeof(uint32_t));
+        for (int i = 0; i < count; ) {
+            IndexRange range = { codepoints[i], 0, (uint16_t)i };
+            do {
+                range.count++;
+                i++;
+            } while (i < count && codepoints[i] == codepoints[i - 1] + 1 && range.count < 0xFFFF);
+            outputBufferWrite(out, &range, sizeof(IndexRange));
+        }
+        uint32_t placeholder = 0;
+        outputBufferWrite(out, &placeholder, getRangeIndexHeaderBytes(segmentCount) - sizeof(uint32_t) - (size_t)segmentCount * sizeof(IndexRange));
+        for (int i = 0; i < count; ++i) {
+            outputBufferWrite(out, &placeholder, sizeof(uint32_t));
+        }
+    } else {
+        for (int i = 0; i < count; ++i) {
+            uint16_t unicode = codepoints[i];
+            uint32_t placeholder = 0;
+            outputBufferWrite(out, &unicode, sizeof(uint16_t));
+            outputBufferWrite(out, &placeholder, sizeof(uint32_t));
+        }
+    }
+
+    GlyphParams params;
+    params.flatness = 1.0f / scale / fontSet->renderMode;
+    params.outlineFormat = options->outlineFormat;
+    params.simplify = options->simplifyTolerance > 0 ? options->simplifyTolerance / scale : 0;
+    params.quantBits = options->quantBits;
+    params.pixelScale = pixelScale;
+    if (pixelScale > 0) {
+        params.simplify = options->simplifyTolerance * (float)(1 << options->fixedPointBits);
+    }
+    if (params.outlineFormat == OUTLINE_FORMAT_CURVES) {
+        params.flatness = 0;  // 曲线格式与字号无关，不同字号共用缓存
+        params.simplify = 0;  // 曲线格式在渲染时才展平，不做简化
+    }
+
+    // 没有字体内容哈希时无法区分不同字体，不使用缓存
+    GlyphCache *cache = options->fontHash ? options->glyphCache : NULL;
+    uint64_t paramsHash = glyphParamsHash(&params);
+
+    // 按线程数把去重后的码位列表切成连续分片
+    int threadCount = options->threadCount > 0 ? options->threadCount : getCpuCount();
+    if (threadCount > count) threadCount = count > 0 ? count : 1;
+
+    GlyphWorker *workers = (GlyphWorker *)calloc(threadCount, sizeof(GlyphWorker));
+    uint32_t *localOffsets = (uint32_t *)malloc((count > 0 ? count : 1) * sizeof(uint32_t));
+    if (!workers || !localOffsets) {
+        fprintf(stderr, "Memory allocation error for glyph workers!\n");
+        free(workers);
+        free(localOffsets);
+        outputBufferFree(out);
+        free(fontSet->fontName);
+        fontSet->fontName = NULL;
+        return -1;
+    }
+
+    for (int t = 0; t < threadCount; ++t) {
+        GlyphWorker *worker = &workers[t];
+        worker->font = font;
+        worker->codepoints = codepoints;
+        worker->glyphIndices = glyphIndices;
+        worker->lookup = options->glyphLookup;
+        worker->begin = (int)((long long)count * t / threadCount);
+        worker->end = (int)((long long)count * (t + 1) / threadCount);
+        worker->params = &params;
+        worker->cache = cache;
+        worker->fontHash = options->fontHash;
+        worker->paramsHash = paramsHash;
+        worker->reuse = reuse;
+        worker->localOffsets = localOffsets;
+        worker->stats = stats;
+        outputBufferInit(&worker->out, (size_t)(worker->end - worker->begin) * 256);
+    }
+
+    runParallel(extractGlyphRange, workers, sizeof(GlyphWorker), threadCount);
+
+    double mergeStart = getTimeMs();
+    BuildCounts totals;
+    memset(&totals, 0, sizeof(BuildCounts));
+
+    // 去重表申请失败时退回不去重，输出仍然有效
+    RecordDedupTable dedup;
+    memset(&dedup, 0, sizeof(RecordDedupTable));
+    if (options->dedupGlyphs) recordDedupInit(&dedup, count);
+
+    // 按分片顺序拼接字形数据，并把局部偏移换算成文件偏移回写到索引区域
+    int result = 0;
+    for (int t = 0; t < threadCount; ++t) {
+        GlyphWorker *worker = &workers[t];
+        if (worker->result != 0) result = -1;
+        totals.reused += worker->counts.reused;
+        totals.extracted += worker->counts.extracted;
+        totals.missing += worker->counts.missing;
+        totals.cached += worker->counts.cached;
+        if (worker->counts.quantError > totals.quantError) totals.quantError = worker->counts.quantError;
+
+        // 缺失的字形在分片中长度为 0：MISSING_GLYPH_NOTDEF 时先标记，最后统一指向共享的缺字记录；
+        // 否则与原来一样指向下一条写入的记录
+        for (int i = worker->begin; i < worker->end; ++i) {
+            uint32_t start = localOffsets[i];
+            uint32_t end = i + 1 < worker->end ? localOffsets[i + 1] : (uint32_t)worker->out.size;
+            if (end == start && options->missingGlyphs == MISSING_GLYPH_NOTDEF) {
+                localOffsets[i] = GLYPH_OFFSET_MISSING;
+                continue;
+            }
+            if (end == start) {
+                uint32_t nextOffset = (uint32_t)out->size;
+                outputBufferPatch(out, indexStartOffset + getIndexOffsetPosition(fontSet->indexLayout, count, segmentCount, i), &nextOffset, sizeof(uint32_t));
+                continue;
+            }
+            int duplicates = totals.duplicates;
+            uint32_t glyphDataStartOffset = writeGlyphRecord(&dedup, out, worker->out.data + start, end - start, &totals);
+            outputBufferPatch(out, indexStartOffset + getIndexOffsetPosition(fontSet->indexLayout, count, segmentCount, i), &glyphDataStartOffset, sizeof(uint32_t));
+            if (stats) {
+                fillGlyphRecordStats(&stats[i], worker->out.data + start, end - start, options->outlineFormat);
+                stats[i].duplicate = totals.duplicates != duplicates;
+            }
+        }
+        outputBufferFree(&worker->out);
+    }
+
+    // 有缺失的码位时追加一条共享的 .notdef（字形 0）记录，索引偏移置最高位，
+    // 读取端只看索引即可拒绝，需要时也能画出缺字框
+    if (result == 0 && totals.missing > 0 && options->missingGlyphs == MISSING_GLYPH_NOTDEF) {
+        OutputBuffer notdef;
+        outputBufferInit(&notdef, 256);
+        if (serializeGlyph(font, 0, &params, &notdef, NULL, &totals.quantError) != 0 || notdef.error) {
+            result = -1;
+        } else {
+            uint32_t missingOffset = writeGlyphRecord(&dedup, out, notdef.data, (uint32_t)notdef.size, &totals) | GLYPH_OFFSET_MISSING;
+            for (int i = 0; i < count; ++i) {
+                if (localOffsets[i] == GLYPH_OFFSET_MISSING) {
+                    outputBufferPatch(out, indexStartOffset + getIndexOffsetPosition(fontSet->indexLayout, count, segmentCount, i), &missingOffset, sizeof(uint32_t));
+                }
+            }
+        }
+        outputBufferFree(&notdef);
+    }
+    recordDedupFree(&dedup);
+
+    // 校验和覆盖尾部之前的全部字节，读取端挂载时校验一次
+    if (result == 0 && options->checksum) {
+        uint32_t trailer[2] = { CHECKSUM_MAGIC, crc32c(0, out->data, out->size) };
+        outputBufferWrite(out, trailer, sizeof(trailer));
+    }
+    totals.quantError *= pixelScale > 0 ? scale / pixelScale : scale;
+    if (counts) *counts = totals;
+
+    if (profile) {
+        for (int t = 0; t < threadCount; ++t) {
+            for (int p = 0; p < PHASE_COUNT; ++p) {
+                profile->phaseMs[p] += workers[t].times.ms[p];
+            }
+        }
+        double buildEnd = getTimeMs();
+        profile->phaseMs[PHASE_MERGE] += buildEnd - mergeStart;
+        profile->wallMs = buildEnd - buildStart;
+        profile->counts = totals;
+        profile->headerBytes = (uint32_t)fontSet->length;
+        profile->indexBytes = (uint32_t)fontSet->indexAreaSize;
+        profile->fileBytes = (uint32_t)out->size;
+        profile->glyphs = stats;
+        profile->glyphCount = stats ? count : 0;
+    }
+    free(workers);
+    free(localOffsets);
+
+    if (result != 0 || out->error) {
+        fprintf(stderr, "Glyph extraction failed!\n");
+        outputBufferFree(out);
+        result = -1;
+    }
+
+    free(fontSet->fontName);
+    fontSet->fontName = NULL;
+
+    return result;
+}
+
+
+// 写出生成结果，写文件耗时计入统计
+static int saveBinOutput(const OutputBuffer *out, const char *binPath, const GenerateOptions *options) {
+    double start = getTimeMs();
+    int result = outputBufferSaveToFile(out, binPath);
+    if (options && options->profile) {
+        double elapsed = getTimeMs() - start;
+        options->profile->phaseMs[PHASE_IO] += elapsed;
+        options->profile->wallMs += elapsed;
+    }
+    return result;
+}
+
+int generateBinFileFromCharset(const stbtt_fontinfo *font, const char *binPath, const Charset *charset, FontSet *fontSet, const GenerateOptions *options) {
+    uint16_t *codepoints;
+    int count = charsetToArray(charset, &codepoints);
+    if (count < 0) {
+        fprintf(stderr, "Memory allocation error for charset!\n");
+        return -1;
+    }
+
+    int result = generateBinFileFromCodepoints(font, binPath, codepoints, count, fontSet, options);
+    free(codepoints);
+    return result;
+}
+
+int generateBinFileFromFont(const stbtt_fontinfo *font, const char *binPath, const char *text, FontSet *fontSet, const GenerateOptions *options) {
+    Charset *charset = (Charset *)calloc(1, sizeof(Charset));
+    if (!charset) {
+        fprintf(stderr, "Memory allocation error for charset!\n");
+        return -1;
+    }
+    charsetAddUtf8Text(charset, text);
+
+    int result = generateBinFileFromCharset(font, binPath, charset, fontSet, options);
+    free(charset);
+    return result;
+}
+
+// 由升序、去重的码位列表生成 bin 文件，例如语料扫描得到的字符集
+int generateBinFileFromCodepoints(const stbtt_fontinfo *font, const char *binPath, const uint16_t *codepoints, int count, FontSet *fontSet, const GenerateOptions *options) {
+    return generateBinFileFromGlyphs(font, binPath, codepoints, NULL, count, fontSet, options);
+}
+
+// 量化格式的误差只能在提取字形时测得，缓存命中和复用的记录不计入
+static void printQuantizeReport(const char *binPath, const FontSet *fontSet, const BuildCounts *counts) {
+    printf("[quantize] %s: %d-bit coordinates, max error %.3f px over %d extracted glyphs\n",
+           binPath, fontSet->quantBits, counts->quantError, counts->extracted - counts->cached);
+}
+
+// 同上，glyphIndices 非空时直接使用给定的字形，不再查询 cmap
+int generateBinFileFromGlyphs(const stbtt_fontinfo *font, const char *binPath, const uint16_t *codepoints, const uint16_t *glyphIndices,
+                              int count, FontSet *fontSet, const GenerateOptions *options) {
+    OutputBuffer out;
+    BuildCounts counts;
+    int result = buildBinFile(font, codepoints, glyphIndices, count, NULL, fontSet, options, &out, &counts);
+    if (result == 0) {
+        result = saveBinOutput(&out, binPath, options);
+    }
+    if (result == 0 && counts.duplicates > 0) {
+        printf("[dedup] %s: %d duplicate glyph records, %u bytes saved\n", binPath, counts.duplicates, counts.savedBytes);
+    }
+    if (result == 0 && fontSet->quantBits) {
+        printQuantizeReport(binPath, fontSet, &counts);
+    }
+
+    outputBufferFree(&out);
+    return result;
+}
+
+// 全量导出：遍历 cmap 得到字体支持的全部 BMP 字符，连同字形一起交给提取流程
+// options 中没有码位→字形表时临时建一张
+int generateBinFileFullCoverage(const stbtt_fontinfo *font, const char *binPath, FontSet *fontSet, const GenerateOptions *options) {
+    GlyphLookup localLookup;
+    const GlyphLookup *lookup = options ? options->glyphLookup : NULL;
+    memset(&localLookup, 0, sizeof(GlyphLookup));
+    if (!lookup) {
+        if (glyphLookupBuild(&localLookup, font) != 0) return -1;
+        lookup = &localLookup;
+    }
+
+    FontCoverage coverage;
+    double start = getTimeMs();
+    int result = getFontCoverage(lookup, &coverage);
+    double elapsed = getTimeMs() - start;
+    if (result == 0) {
+        result = generateBinFileFromGlyphs(font, binPath, coverage.codepoints, coverage.glyphIndices, coverage.count, fontSet, options);
+        freeFontCoverage(&coverage);
+    }
+    if (options && options->profile) {
+        options->profile->phaseMs[PHASE_CMAP] += elapsed;
+        options->profile->wallMs += elapsed;
+    }
+    glyphLookupFree(&localLookup);
+    return result;
+}
+
+static int compareGlyphStatsBySize(const void *a, const void *b) {
+    const GlyphStats *ga = (const GlyphStats *)a;
+    const GlyphStats *gb = (const GlyphStats *)b;
+    if (ga->bytes != gb->bytes) return ga->bytes < gb->bytes ? 1 : -1;
+    return (int)ga->codepoint - (int)gb->codepoint;
+}
+
+// 按记录大小降序取前 topCount 个字形，返回实际个数；调用方释放 *largest
+static int getLargestGlyphs(const GenerateProfile *profile, int topCount, GlyphStats **largest) {
+    *largest = (GlyphStats *)malloc((profile->glyphCount > 0 ? profile->glyphCount : 1) * sizeof(GlyphStats));
+    if (!*largest) return 0;
+    memcpy(*largest, profile->glyphs, profile->glyphCount * sizeof(GlyphStats));
+    qsort(*largest, profile->glyphCount, sizeof(GlyphStats), compareGlyphStatsBySize);
+    return topCount < profile->glyphCount ? topCount : profile->glyphCount;
+}
+
+// 存在的字形中某项指标的最小、最大、平均值
+typedef struct {
+    uint32_t min;
+    uint32_t max;
+    double avg;
+} StatsSummary;
+
+static void summarizeGlyphStats(const GenerateProfile *profile, StatsSummary summaries[3]) {
+    int present = 0;
+    double sums[3] = { 0, 0, 0 };
+    for (int k = 0; k < 3; ++k) {
+        summaries[k].min = 0;
+        summaries[k].max = 0;
+        summaries[k].avg = 0;
+    }
+    for (int i = 0; i < profile->glyphCount; ++i) {
+        const GlyphStats *glyph = &profile->glyphs[i];
+        if (glyph->source == GLYPH_SOURCE_MISSING) continue;
+        uint32_t values[3] = { glyph->bytes, glyph->points, glyph->windings };
+        for (int k = 0; k < 3; ++k) {
+            if (present == 0 || values[k] < summaries[k].min) summaries[k].min = values[k];
+            if (values[k] > summaries[k].max) summaries[k].max = values[k];
+            sums[k] += values[k];
+        }
+        present++;
+    }
+    for (int k = 0; k < 3; ++k) {
+        summaries[k].avg = present ? sums[k] / present : 0;
+    }
+}
+
+// 打印生成统计摘要和最大的 topCount 个字形
+void printGenerateProfile(const GenerateProfile *profile, const char *binPath, int topCount) {
+    printf("[profile] %s: %u bytes (header %u, index %u, glyphs %u), %.2f ms\n", binPath, profile->fileBytes,
+           profile->headerBytes, profile->indexBytes, profile->fileBytes - profile->headerBytes - profile->indexBytes, profile->wallMs);
+    printf("[profile] phases (ms):");
+    for (int p = 0; p < PHASE_COUNT; ++p) {
+        printf(" %s %.2f", phaseNames[p], profile->phaseMs[p]);
+    }
+    printf("\n");
+
+    StatsSummary summaries[3];
+    summarizeGlyphStats(profile, summaries);
+    printf("[profile] per glyph: bytes avg %.1f max %u, points avg %.1f max %u, windings avg %.1f max %u\n",
+           summaries[0].avg, summaries[0].max, summaries[1].avg, summaries[1].max, summaries[2].avg, summaries[2].max);
+
+    GlyphStats *largest;
+    int largestCount = getLargestGlyphs(profile, topCount, &largest);
+    for (int i = 0; i < largestCount; ++i) {
+        printf("[profile] #%d U+%04X glyph %u: %u bytes, %u points, %u windings\n", i + 1, largest[i].codepoint,
+               largest[i].glyphIndex, largest[i].bytes, largest[i].points, largest[i].windings);
+    }
+    free(largest);
+}
+
+static void writeGlyphStatsJson(FILE *file, const GlyphStats *glyph) {
+    fprintf(file, "{\"codepoint\": %u, \"glyph\": %u, \"bytes\": %u, \"points\": %u, \"windings\": %u, \"source\": \"%s\", \"duplicate\": %s}",
+            glyph->codepoint, glyph->glyphIndex, glyph->bytes, glyph->points, glyph->windings,
+            glyphSourceNames[glyph->source], glyph->duplicate ? "true" : "false");
+}
+
+// 保存生成统计。路径以 .csv 结尾时每个字形一行，否则写 JSON：
+// 各阶段耗时、字节构成、字形计数、每字形指标汇总、最大的 topCount 个字形以及全部字形
+int saveGenerateProfile(const GenerateProfile *profile, const char *binPath, int topCount, const char *path) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "Error opening profile file %s!\n", path);
+        return -1;
+    }
+
+    size_t pathLength = strlen(path);
+    if (pathLength >= 4 && strcmp(path + pathLength - 4, ".csv") == 0) {
+        fprintf(file, "codepoint,glyph,bytes,points,windings,source,duplicate\n");
+        for (int i = 0; i < profile->glyphCount; ++i) {
+            const GlyphStats *glyph = &profile->glyphs[i];
+            fprintf(file, "%u,%u,%u,%u,%u,%s,%u\n", glyph->codepoint, glyph->glyphIndex, glyph->bytes, glyph->points,
+                    glyph->windings, glyphSourceNames[glyph->source], glyph->duplicate);
+        }
+    } else {
+        const BuildCounts *counts = &profile->counts;
+        fprintf(file, "{\n  \"bin\": \"");
+        for (const char *p = binPath; *p; ++p) {
+            if (*p == '"' || *p == '\\') fputc('\\', file);
+            fputc(*p, file);
+        }
+        fprintf(file, "\",\n  \"wallMs\": %.3f,\n  \"phasesMs\": {", profile->wallMs);
+        for (int p = 0; p < PHASE_COUNT; ++p) {
+            fprintf(file, "%s\"%s\": %.3f", p ? ", " : "", phaseNames[p], profile->phaseMs[p]);
+        }
+        fprintf(file, "},\n  \"bytes\": {\"file\": %u, \"header\": %u, \"index\": %u, \"glyphs\": %u, \"dedupSaved\": %u},\n",
+                profile->fileBytes, profile->headerBytes, profile->indexBytes,
+                profile->fileBytes - profile->headerBytes - profile->indexBytes, counts->savedBytes);
+        fprintf(file, "  \"counts\": {\"glyphs\": %d, \"extracted\": %d, \"cached\": %d, \"reused\": %d, \"missing\": %d, \"duplicates\": %d},\n",
+                profile->glyphCount, counts->extracted, counts->cached, counts->reused, counts->missing, counts->duplicates);
+
+        static const char *const metricNames[3] = { "bytes", "points", "windings" };
+        StatsSummary summaries[3];
+        summarizeGlyphStats(profile, summaries);
+        fprintf(file, "  \"perGlyph\": {");
+        for (int k = 0; k < 3; ++k) {
+            fprintf(file, "%s\"%s\": {\"min\": %u, \"max\": %u, \"avg\": %.2f}", k ? ", " : "",
+                    metricNames[k], summaries[k].min, summaries[k].max, summaries[k].avg);
+        }
+        fprintf(file, "},\n  \"largest\": [");
+
+        GlyphStats *largest;
+        int largestCount = getLargestGlyphs(profile, topCount, &largest);
+        for (int i = 0; i < largestCount; ++i) {
+            fprintf(file, "%s\n    ", i ? "," : "");
+            writeGlyphStatsJson(file, &largest[i]);
+        }
+        free(largest);
+
+        fprintf(file, "\n  ],\n  \"glyphList\": [");
+        for (int i = 0; i < profile->glyphCount; ++i) {
+            fprintf(file, "%s\n    ", i ? "," : "");
+            writeGlyphStatsJson(file, &profile->glyphs[i]);
+        }
+        fprintf(file, "\n  ]\n}\n");
+    }
+
+    int result = ferror(file) ? -1 : 0;
+    if (fclose(file) != 0) result = -1;
+    if (result != 0) fprintf(stderr, "Error writing profile file %s!\n", path);
+    return result;
+}
+
+void printFontSet(const FontSet *fontSet) {
+    printf("FontSet Information:\n");
+    printf("Length: %d\n", fontSet->length);
+    printf("FileFlag: %d\n", fontSet->fileFlag);
+    printf("Version: %.4s\n", fontSet->version);
+    printf("FontSize: %d\n", fontSet->fontSize);
+    printf("RenderMode: %d\n", fontSet->renderMode);
+    printf("Bold: %d\n", fontSet->bold);
+    printf("Italic: %d\n", fontSet->italic);
+    printf("ScanMode: %d\n", fontSet->scanMode);
+    printf("IndexMethod: %d\n", fontSet->indexMethod);
+    printf("IndexAreaSize: %d\n", fontSet->indexAreaSize);
+    printf("FontNameLength: %d\n", fontSet->fontNameLength);
+    printf("Ascent: %d\n", fontSet->ascent);
+    printf("Descent: %d\n", fontSet->descent);
+    printf("LineGap: %d\n", fontSet->lineGap);
+    printf("FontName: %s\n", fontSet->fontName);
+    if (fontSet->quantBits) printf("QuantBits: %d\n", fontSet->quantBits);
+    if (fontSet->fixedPointBits) printf("FixedPointBits: %d, FontScale: %f\n", fontSet->fixedPointBits, fontSet->fontScale);
+    if (fontSet->indexLayout) printf("IndexLayout: %d\n", fontSet->indexLayout);
+    if (fontSet->fontHash) printf("FontHash: %016llx\n", (unsigned long long)fontSet->fontHash);
+    if (fontSet->simplifyTolerance > 0) printf("SimplifyTolerance: %g\n", fontSet->simplifyTolerance);
+}
+
+// 解析扩展头部字段，不认识的字段跳过，格式错误时返回 -1
+static int parseFontSetExt(const uint8_t *ext, size_t size, FontSet *fontSet) {
+    fontSet->quantBits = 0;
+    fontSet->fixedPointBits = 0;
+    fontSet->fontScale = 0;
+    fontSet->indexLayout = INDEX_LAYOUT_INTERLEAVED;
+    fontSet->fontHash = 0;
+    fontSet->simplifyTolerance = 0;
+    for (size_t pos = 0; pos < size; ) {
+        if (size - pos < 2 || size - pos - 2 < ext[pos + 1]) return -1;
+        uint8_t tag = ext[pos], fieldSize = ext[pos + 1];
+        const uint8_t *data = ext + pos + 2;
+        if (tag == HEADER_EXT_QUANT_BITS && fieldSize >= 1) {
+            fontSet->quantBits = data[0];
+        } else if (tag == HEADER_EXT_PIXEL_SPACE && fieldSize >= 1 + 4) {
+            fontSet->fixedPointBits = data[0];
+            memcpy(&fontSet->fontScale, data + 1, sizeof(float));
+        } else if (tag == HEADER_EXT_INDEX_LAYOUT && fieldSize >= 1) {
+            if (data[0] > INDEX_LAYOUT_PAGED) return -1;  // 不认识的索引布局无法查找
+            fontSet->indexLayout = data[0];
+        } else if (tag == HEADER_EXT_FONT_HASH && fieldSize >= 8) {
+            memcpy(&fontSet->fontHash, data, sizeof(uint64_t));
+        } else if (tag == HEADER_EXT_SIMPLIFY && fieldSize >= 4) {
+            memcpy(&fontSet->simplifyTolerance, data, sizeof(float));
+        }
+        pos += 2 + fieldSize;
+    }
+    return 0;
+}
+
+// 解析头部的固定字段和扩展头部，不复制字体名（fontSet->fontName 置空），返回索引区起始偏移，格式错误时返回 -1。
+// 查找、读取字形的函数都使用解析好的 FontSet，不再逐次从 mem 中重新计算头部长度和扩展字段
+static int parseBinHeaderFields(const uint8_t *mem, size_t size, FontSet *fontSet) {
+    const size_t fixedLength = FONTSET_FIXED_LENGTH;
+    fontSet->fontName = NULL;
+    if (size < fixedLength) return -1;
+
+    const uint8_t *ptr = mem;
+    fontSet->length = (char)*ptr++;
+    fontSet->fileFlag = (char)*ptr++;
+    memcpy(fontSet->version, ptr, 4);
+    ptr += 4;
+    fontSet->fontSize = (char)*ptr++;
+    fontSet->renderMode = (char)*ptr++;
+
+    unsigned char flagByte = *ptr++;
+    fontSet->bold = (flagByte >> 7) & 1;
+    fontSet->italic = (flagByte >> 6) & 1;
+    fontSet->scanMode = (flagByte >> 5) & 1;
+    fontSet->indexMethod = (flagByte >> 4) & 1;
+    fontSet->rsvd = flagByte & 0x0F;
+
+    memcpy(&fontSet->indexAreaSize, ptr, sizeof(int));
+    ptr += sizeof(int);
+    fontSet->fontNameLength = *ptr++;
+    memcpy(&fontSet->ascent, ptr, sizeof(short));
+    memcpy(&fontSet->descent, ptr + 2, sizeof(short));
+    memcpy(&fontSet->lineGap, ptr + 4, sizeof(short));
+    ptr += sizeof(short) * 3;
+
+    if (fixedLength + fontSet->fontNameLength > size) return -1;
+    if (fontSet->indexAreaSize < 0 || (size_t)fontSet->indexAreaSize > size - fixedLength - fontSet->fontNameLength) return -1;
+
+    // 头部长度不含扩展时等于固定字段加字体名，更短说明头部损坏或长度溢出
+    size_t headerLength = (uint8_t)fontSet->length;
+    if (headerLength < fixedLength + fontSet->fontNameLength) return -1;
+    if (memcmp(fontSet->version, FONTSET_VERSION_EXTENDED, 4) > 0) return -1;  // 更新的格式，不认识的位无法解读
+    if (headerLength > size || (size_t)fontSet->indexAreaSize > size - headerLength) return -1;
+    if (parseFontSetExt(mem + fixedLength + fontSet->fontNameLength,
+                        headerLength - fixedLength - fontSet->fontNameLength, fontSet) != 0) return -1;
+    return (int)headerLength;
+}
+
+// 从内存解析 bin 文件头部，布局与 readBinFile 一致，返回索引区起始偏移，格式错误时返回 -1。
+// 成功时 fontSet->fontName 为新分配的字符串，由调用方释放
+int parseBinHeader(const uint8_t *mem, size_t size, FontSet *fontSet) {
+    int headerLength = parseBinHeaderFields(mem, size, fontSet);
+    if (headerLength < 0) return -1;
+
+    fontSet->fontName = (char *)malloc(fontSet->fontNameLength + 1);
+    if (!fontSet->fontName) return -1;
+    memcpy(fontSet->fontName, mem + FONTSET_FIXED_LENGTH, fontSet->fontNameLength);
+    fontSet->fontName[fontSet->fontNameLength] = '\0';
+    return headerLength;
+}
+
+void readBinFile(const char *binPath) {
+    FILE *binFile = fopen(binPath, "rb");
+    if (!binFile) {
+        fprintf(stderr, "Error opening BIN file!\n");
+        return;
+    }
+
+    fseek(binFile, 0, SEEK_END);
+    long size = ftell(binFile);
+    fseek(binFile, 0, SEEK_SET);
+
+    if (size < sizeof(char)) {
+        fprintf(stderr, "BIN file is too small!\n");
+        fclose(binFile);
+        return;
+    }
+
+    FontSet fontSet;
+    fread(&fontSet.length, sizeof(char), 1, binFile);
+    fread(&fontSet.fileFlag, sizeof(char), 1, binFile);
+    fread(fontSet.version, sizeof(char), 4, binFile);
+    fread(&fontSet.fontSize, sizeof(char), 1, binFile);
+    fread(&fontSet.renderMode, sizeof(char), 1, binFile);
+
+    unsigned char flagByte;
+    fread(&flagByte, sizeof(char), 1, binFile);
+    fontSet.bold = (flagByte >> 7) & 1;
+    fontSet.italic = (flagByte >> 6) & 1;
+    fontSet.scanMode = (flagByte >> 5) & 1;
+    fontSet.indexMethod = (flagByte >> 4) & 1;
+
+    fread(&fontSet.indexAreaSize, sizeof(int), 1, binFile);
+    fread(&fontSet.fontNameLength, sizeof(uint8_t), 1, binFile);
+    fread(&fontSet.ascent, sizeof(short), 1, binFile);
+    fread(&fontSet.descent, sizeof(short), 1, binFile);
+    fread(&fontSet.lineGap, sizeof(short), 1, binFile);
+
+    fontSet.fontName = (char *)malloc(fontSet.fontNameLength + 1);
+    if (!fontSet.fontName) {
+        fprintf(stderr, "Memory allocation error for font name!\n");
+        fclose(binFile);
+        return;
+    }
+    fread(fontSet.fontName, sizeof(char), fontSet.fontNameLength, binFile);
+    fontSet.fontName[fontSet.fontNameLength] = '\0';
+
+    // 扩展头部
+    uint8_t ext[255];
+    size_t baseLength = FONTSET_FIXED_LENGTH + fontSet.fontNameLength;
+    if ((uint8_t)fontSet.length < baseLength) {
+        fprintf(stderr, "Invalid header length!\n");
+        free(fontSet.fontName);
+        fclose(binFile);
+        return;
+    }
+    size_t extLength = (uint8_t)fontSet.length - baseLength;
+    fontSet.quantBits = 0;
+    fontSet.fixedPointBits = 0;
+    fontSet.fontScale = 0;
+    fontSet.indexLayout = INDEX_LAYOUT_INTERLEAVED;
+    if (extLength > 0 && (fread(ext, 1, extLength, binFile) != extLength || parseFontSetExt(ext, extLength, &fontSet) != 0)) {
+        fprintf(stderr, "Invalid header extension!\n");
+        free(fontSet.fontName);
+        fclose(binFile);
+        return;
+    }
+
+    // 打印 FontSet 结构体内容
+    printFontSet(&fontSet);
+
+    MappedFile mapped;
+    if ((flagByte & FONTSET_FLAG_CHECKSUM) && mapFileReadOnly(binPath, &mapped) == 0) {
+        printf("Checksum: %s\n", verifyBinChecksum(mapped.data, mapped.size) > 0 ? "OK" : "MISMATCH");
+        unmapFile(&mapped);
+    }
+    printf("Outline format: %d\n", flagByte & OUTLINE_FORMAT_MASK);
+
+    if (fontSet.indexAreaSize <= 0) {
+        fprintf(stderr, "Index area size is invalid!\n");
+        free(fontSet.fontName);
+        fclose(binFile);
+        return;
+    }
+
+    GlyphEntry *glyphEntries = (GlyphEntry *)malloc((fontSet.indexAreaSize / sizeof(uint32_t) + 1) * sizeof(GlyphEntry));
+    if (!glyphEntries) {
+        fprintf(stderr, "Memory allocation error for glyph entries!\n");
+        free(fontSet.fontName);
+        fclose(binFile);
+        return;
+    }
+
+    int entryCount = fontSet.indexAreaSize / sizeof(GlyphEntry);
+    if (fontSet.indexLayout == INDEX_LAYOUT_SPLIT) {
+        // 码位和偏移分开存放，分别读取
+        long indexStart = ftell(binFile);
+        entryCount = fontSet.indexAreaSize / (2 + 4);
+        for (int i = 0; i < entryCount; ++i) {
+            if (fread(&glyphEntries[i].unicode, sizeof(uint16_t), 1, binFile) != 1) break;
+        }
+        fseek(binFile, indexStart + (long)getSplitIndexKeyBytes(entryCount), SEEK_SET);
+        for (int i = 0; i < entryCount; ++i) {
+            if (fread(&glyphEntries[i].offset, sizeof(uint32_t), 1, binFile) != 1) {
+                fprintf(stderr, "Error reading glyph entry!\n");
+                free(glyphEntries);
+                free(fontSet.fontName);
+                fclose(binFile);
+                return;
+            }
+        }
+    } else if (fontSet.indexLayout == INDEX_LAYOUT_RANGES) {
+        // 整个索引区读入内存，按段展开出每一项的码位
+        uint8_t *index = (uint8_t *)malloc(fontSet.indexAreaSize);
+        int segmentCount = 0;
+        entryCount = -1;
+        if (index && fread(index, 1, fontSet.indexAreaSize, binFile) == (size_t)fontSet.indexAreaSize) {
+            entryCount = getRangeIndexCounts(index, fontSet.indexAreaSize, &segmentCount);
+        }
+        if (entryCount < 0) {
+            fprintf(stderr, "Error reading range index!\n");
+            free(index);
+            free(glyphEntries);
+            free(fontSet.fontName);
+            fclose(binFile);
+            return;
+        }
+        printf("Index ranges: %d\n", segmentCount);
+        const IndexRange *ranges = (const IndexRange *)(index + sizeof(uint32_t));
+        int filled = 0;
+        for (int j = 0; j < segmentCount; ++j) {
+            for (int k = 0; k < ranges[j].count && ranges[j].firstSlot + k < entryCount; ++k, ++filled) {
+                glyphEntries[ranges[j].firstSlot + k].unicode = (uint16_t)(ranges[j].start + k);
+            }
+        }
+        for (int i = 0; i < entryCount; ++i) {
+            memcpy(&glyphEntries[i].offset, index + getIndexOffsetPosition(INDEX_LAYOUT_RANGES, entryCount, segmentCount, i), sizeof(uint32_t));
+        }
+        if (filled != entryCount) entryCount = 0;
+        free(index);
+    } else if (fontSet.indexLayout == INDEX_LAYOUT_PAGED) {
+        // 整个索引区读入内存，由页号和低字节拼出每一项的码位
+        uint8_t *index = (uint8_t *)malloc(fontSet.indexAreaSize);
+        entryCount = -1;
+        if (index && fread(index, 1, fontSet.indexAreaSize, binFile) == (size_t)fontSet.indexAreaSize) {
+            entryCount = getPagedIndexCount(index, fontSet.indexAreaSize);
+        }
+        if (entryCount < 0) {
+            fprintf(stderr, "Error reading paged index!\n");
+            free(index);
+            free(glyphEntries);
+            free(fontSet.fontName);
+            fclose(binFile);
+            return;
+        }
+        const IndexPage *pages = (const IndexPage *)index;
+        const uint8_t *lowKeys = index + INDEX_PAGE_COUNT * sizeof(IndexPage);
+        int usedPages = 0;
+        for (int page = 0; page < INDEX_PAGE_COUNT; ++page) {
+            usedPages += pages[page].count != 0;
+            for (int k = 0; k < pages[page].count; ++k) {
+                glyphEntries[pages[page].start + k].unicode = (uint16_t)(page << 8 | lowKeys[pages[page].start + k]);
+            }
+        }
+        printf("Index pages: %d\n", usedPages);
+        for (int i = 0; i < entryCount; ++i) {
+            memcpy(&glyphEntries[i].offset, index + getIndexOffsetPosition(INDEX_LAYOUT_PAGED, entryCount, 0, i), sizeof(uint32_t));
+        }
+        free(index);
+    }
+    for (int i = 0; fontSet.indexLayout == INDEX_LAYOUT_INTERLEAVED && i < entryCount; ++i) {
+        if (fread(&glyphEntries[i].unicode, sizeof(uint16_t), 1, binFile) != 1 ||
+            fread(&glyphEntries[i].offset, sizeof(uint32_t), 1, binFile) != 1) {
+            fprintf(stderr, "Error reading glyph entry!\n");
+            free(glyphEntries);
+            free(fontSet.fontName);
+            fclose(binFile);
+            return;
+        }
+    }
+
+    // 打印前三个字的 Unicode 编码及其在文件中的地址
+    printf("Index\tUnicode\tAddress\n");
+    for (int i = 0; i < entryCount && i < 3; ++i) {
+        printf("%d\t0x%04X\t0x%08X\n", i + 1, glyphEntries[i].unicode, glyphEntries[i].offset);
+    }
+
+    // 打印第一个字的全部信息
+    if (entryCount > 0) {
+        fseek(binFile, glyphEntries[0].offset & GLYPH_OFFSET_MASK, SEEK_SET);
+
+        short x0, y0, x1, y1;
+        if (fread(&x0, sizeof(short), 1, binFile) != 1 ||
+            fread(&y0, sizeof(short), 1, binFile) != 1 ||
+            fread(&x1, sizeof(short), 1, binFile) != 1 ||
+            fread(&y1, sizeof(short), 1, binFile) != 1) {
+            fprintf(stderr, "Error reading glyph bounding box!\n");
+            free(glyphEntries);
+            free(fontSet.fontName);
+            fclose(binFile);
+            return;
+        }
+
+        short advance;
+        if (fread(&advance, sizeof(short), 1, binFile) != 1) {
+            fprintf(stderr, "Error reading glyph advance!\n");
+            free(glyphEntries);
+            free(fontSet.fontName);
+            fclose(binFile);
+            return;
+        }
+
+    printf("Character: 0x%04X, x0: %d, y0: %d, x1: %d, y1: %d, advance: %d\n",
+           glyphEntries[0].unicode, x0, y0, x1, y1, advance);
+
+        if ((flagByte & OUTLINE_FORMAT_MASK) == OUTLINE_FORMAT_EDGES) {
+            uint16_t edgeCount = 0;
+            if (fread(&edgeCount, sizeof(uint16_t), 1, binFile) != 1) {
+                fprintf(stderr, "Error reading edge count!\n");
+            } else {
+                printf("Number of edges: %d\n", edgeCount);
+            }
+            free(glyphEntries);
+            free(fontSet.fontName);
+            fclose(binFile);
+            return;
+        }
+
+        uint8_t winding_count;
+        if (fread(&winding_count, sizeof(uint8_t), 1, binFile) != 1) {
+            fprintf(stderr, "Error reading winding count!\n");
+            free(glyphEntries);
+            free(fontSet.fontName);
+            fclose(binFile);
+            return;
+        }
+
+        printf("Number of winding paths: %d\n", winding_count);
+
+        uint8_t *winding_lengths = (uint8_t *)malloc(winding_count * sizeof(uint8_t));
+        if (!winding_lengths) {
+            fprintf(stderr, "Memory allocation error for winding lengths!\n");
+            free(glyphEntries);
+            free(fontSet.fontName);
+            fclose(binFile);
+            return;
+        }
+
+        if (fread(winding_lengths, sizeof(uint8_t), winding_count, binFile) != winding_count) {
+            fprintf(stderr, "Error reading winding lengths!\n");
+            free(winding_lengths);
+            free(glyphEntries);
+            free(fontSet.fontName);
+            fclose(binFile);
+            return;
+        }
+
+        for (int j = 0; j < winding_count; ++j) {
+            printf("Winding %d has %d segments\n", j, winding_lengths[j]);
+            // 差值格式的点是变长的，这里只逐点读取原始格式
+            for (int k = 0; (flagByte & OUTLINE_FORMAT_MASK) == OUTLINE_FORMAT_RAW && k < winding_lengths[j]; ++k) {
+                short wx, wy;
+                if (fread(&wx, sizeof(short), 1, binFile) != 1 ||
+                    fread(&wy, sizeof(short), 1, binFile) != 1) {
+                    fprintf(stderr, "Error reading windings data!\n");
+                    free(winding_lengths);
+                    free(glyphEntries);
+                    free(fontSet.fontName);
+                    fclose(binFile);
+                    return;
+                }
+                // printf("Character: 0x%04X, Winding Point %d-%d: x = %d, y = %d\n", glyphEntries[0].unicode, j, k, wx, wy);
+            }
+        }
+
+        free(winding_lengths);
+    }
+
+    free(glyphEntries);
+    free(fontSet.fontName);
+    fclose(binFile);
+}
+
+#if defined(INDEX_SEARCH_LANES)
+// 有序索引先二分查找到一条 cache line（32 个码位）以内，再一次比较完
+#define INDEX_SEARCH_WINDOW 32
+
+// keys[0..INDEX_SEARCH_LANES) 中与 unicode 相等的码位的位掩码，每个码位占 1 << INDEX_SEARCH_MASK_SHIFT 位
+#if defined(__AVX2__)
+#define INDEX_SEARCH_MASK_SHIFT 1
+static uint64_t matchIndexKeys(const uint16_t *keys, uint16_t unicode) {
+    __m256i equal = _mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i *)keys), _mm256_set1_epi16((short)unicode));
+    return (uint32_t)_mm256_movemask_epi8(equal);
+}
+#elif defined(__ARM_NEON)
+#define INDEX_SEARCH_MASK_SHIFT 3
+static uint64_t matchIndexKeys(const uint16_t *keys, uint16_t unicode) {
+    uint16x8_t equal = vceqq_u16(vld1q_u16(keys), vdupq_n_u16(unicode));
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(equal, 4)), 0);
+}
+#else
+#define INDEX_SEARCH_MASK_SHIFT 1
+static uint64_t matchIndexKeys(const uint16_t *keys, uint16_t unicode) {
+    __m128i equal = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *)keys), _mm_set1_epi16((short)unicode));
+    return (uint32_t)_mm_movemask_epi8(equal);
+}
+#endif
+
+static int countTrailingZeros64(uint64_t value) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(value);
+#else
+    int bit = 0;
+    while (!((value >> bit) & 1)) bit++;
+    return bit;
+#endif
+}
+#else
+#define INDEX_SEARCH_WINDOW 1
+#endif
+
+// 在连续的 count 个码位中查找 unicode，返回序号，未找到返回 -1；不要求有序
+static int scanIndexKeys(const uint16_t *keys, int count, uint16_t unicode) {
+    int i = 0;
+#if defined(INDEX_SEARCH_LANES)
+    for (; i + INDEX_SEARCH_LANES <= count; i += INDEX_SEARCH_LANES) {
+        uint64_t mask = matchIndexKeys(keys + i, unicode);
+        if (mask) return i + (countTrailingZeros64(mask) >> INDEX_SEARCH_MASK_SHIFT);
+    }
+    // 剩余不足一组时与前一组重叠着比较最后 INDEX_SEARCH_LANES 个码位
+    if (i < count && count >= INDEX_SEARCH_LANES) {
+        i = count - INDEX_SEARCH_LANES;
+        uint64_t mask = matchIndexKeys(keys + i, unicode);
+        return mask ? i + (countTrailingZeros64(mask) >> INDEX_SEARCH_MASK_SHIFT) : -1;
+    }
+#endif
+    for (; i < count; ++i) {
+        if (keys[i] == unicode) return i;
+    }
+    return -1;
+}
+
+// 在严格升序的 count 个码位中查找：二分查找缩小到 INDEX_SEARCH_WINDOW 个码位以内，再整段比较
+static int searchSortedIndexKeys(const uint16_t *keys, int count, uint16_t unicode) {
+    if (count <= INDEX_SEARCH_WINDOW) return scanIndexKeys(keys, count, unicode);
+
+    const uint16_t *base = keys;
+    for (int n = count; n > INDEX_SEARCH_WINDOW; ) {
+        int half = n / 2;
+        base += base[half] <= unicode ? half : 0;
+        n -= half;
+    }
+    // 结果在 [base, base + n) 中；窗口靠近末尾时整体前移，保证不越过数组末尾
+    if (base > keys + count - INDEX_SEARCH_WINDOW) base = keys + count - INDEX_SEARCH_WINDOW;
+    int found = scanIndexKeys(base, INDEX_SEARCH_WINDOW, unicode);
+    return found < 0 ? -1 : (int)(base - keys) + found;
+}
+
+// 在 count 个码位中查找，keys 指向第一个码位，相邻码位相隔 keyStride 字节（交错布局为 6，分离布局为 2），
+// 返回项的序号，未找到返回 -1。INDEX_METHOD_SORTED 时二分查找：每轮只按比较结果移动 base，
+// 编译为条件传送，没有难以预测的分支；分离布局下只访问码位数组，每条 cache line 可容纳 32 个码位，
+// 并且可以用 SIMD 一次比较多个码位
+static int findIndexEntry(const uint8_t *keys, size_t keyStride, int count, int indexMethod, uint16_t unicode) {
+    uint16_t key;
+    if (count <= 0) return -1;
+    if (keyStride == sizeof(uint16_t)) {
+        // 分离布局的码位数组按 4 字节对齐，可以直接按 uint16_t 访问
+        const uint16_t *keyArray = (const uint16_t *)keys;
+        if (indexMethod == INDEX_METHOD_SORTED) return searchSortedIndexKeys(keyArray, count, unicode);
+        return scanIndexKeys(keyArray, count, unicode);
+    }
+    if (indexMethod != INDEX_METHOD_SORTED) {
+        for (int i = 0; i < count; ++i) {
+            memcpy(&key, keys + (size_t)i * keyStride, sizeof(uint16_t));
+            if (key == unicode) return i;
+        }
+        return -1;
+    }
+
+    const uint8_t *base = keys;
+    for (int n = count; n > 1; ) {
+        int half = n / 2;
+        memcpy(&key, base + (size_t)half * keyStride, sizeof(uint16_t));
+        base += key <= unicode ? (size_t)half * keyStride : 0;
+        n -= half;
+    }
+    memcpy(&key, base, sizeof(uint16_t));
+    return key == unicode ? (int)((size_t)(base - keys) / keyStride) : -1;
+}
+
+// 返回指定 Unicode 字符在二进制文件中的字形数据偏移地址，不存在则返回 0
+int getGlyphOffsetFromBinFile(uint16_t unicode, const char *binFilePath) {
+    FILE *binFile = fopen(binFilePath, "rb");
+    if (!binFile) {
+        fprintf(stderr, "Error opening BIN file %s!\n", binFilePath);
+        return 0;
+    }
+
+    FontSet fontSetHeader;
+
+    // 读取并跳过第一个头部数据块
+    fread(&fontSetHeader.length, sizeof(char), 1, binFile);
+    fseek(binFile, 1 + 4 + 1 + 1, SEEK_CUR); // 跳过其余部分:fileFlag（1字节）, version（4字节）， fontSize（1字节）， renderMode（1字节）
+
+    // 读取和解析标志字节
+    unsigned char flags;
+    fread(&flags, sizeof(unsigned char), 1, binFile);
+    fontSetHeader.bold = (flags >> 7) & 0x01;
+    fontSetHeader.italic = (flags >> 6) & 0x01;
+    fontSetHeader.scanMode = (flags >> 5) & 0x01;
+    fontSetHeader.indexMethod = (flags >> 4) & 0x01;
+    fontSetHeader.rsvd = flags & 0x0F;
+
+    // 读取 indexAreaSize
+    fread(&fontSetHeader.indexAreaSize, sizeof(int), 1, binFile);
+
+    // 跳过其余头部数据
+    fread(&fontSetHeader.fontNameLength, sizeof(uint8_t), 1, binFile);
+    fseek(binFile, sizeof(short) * 3 + fontSetHeader.fontNameLength, SEEK_CUR);  // 跳过 ascent, descent, lineGap 和 fontName
+    // 扩展头部中只关心索引区布局
+    fontSetHeader.indexLayout = INDEX_LAYOUT_INTERLEAVED;
+    if ((uint8_t)fontSetHeader.length < ftell(binFile)) {
+        fprintf(stderr, "Invalid header length in %s!\n", binFilePath);
+        fclose(binFile);
+        return 0;
+    }
+    if ((uint8_t)fontSetHeader.length > ftell(binFile)) {
+        uint8_t ext[255];
+        size_t extLength = (uint8_t)fontSetHeader.length - ftell(binFile);
+        if (fread(ext, 1, extLength, binFile) != extLength || parseFontSetExt(ext, extLength, &fontSetHeader) != 0) {
+            fprintf(stderr, "Invalid header extension in %s!\n", binFilePath);
+            fclose(binFile);
+            return 0;
+        }
+    }
+
+    // 读取并解析索引区；有序索引只按二分查找读取 log2(n) 个码位
+    int indexEntries = fontSetHeader.indexAreaSize / (sizeof(uint16_t) + sizeof(int));
+    if (fontSetHeader.indexLayout == INDEX_LAYOUT_RANGES) {
+        // 分段布局只读取段表和命中的一项偏移
+        long indexStart = ftell(binFile);
+        uint32_t segmentCount = 0;
+        int glyphOffset = 0;
+        fread(&segmentCount, sizeof(uint32_t), 1, binFile);
+        IndexRange *ranges = segmentCount <= 0xFFFF ? (IndexRange *)malloc((segmentCount + 1) * sizeof(IndexRange)) : NULL;
+        if (ranges && fread(ranges, sizeof(IndexRange), segmentCount, binFile) == segmentCount) {
+            int slot = findRangeSlot(ranges, (int)segmentCount, unicode);
+            if (slot >= 0) {
+                fseek(binFile, indexStart + (long)getIndexOffsetPosition(INDEX_LAYOUT_RANGES, 0, (int)segmentCount, slot), SEEK_SET);
+                if (fread(&glyphOffset, sizeof(int), 1, binFile) != 1) glyphOffset = 0;
+            }
+        }
+        free(ranges);
+        fclose(binFile);
+        return (glyphOffset & GLYPH_OFFSET_MISSING) ? 0 : glyphOffset;  // 缺字的码位按未找到处理
+    }
+    if (fontSetHeader.indexLayout == INDEX_LAYOUT_PAGED) {
+        // 两级索引只读取一项页表、一页的低字节和命中的一项偏移
+        long indexStart = ftell(binFile);
+        IndexPage page = { 0, 0 }, lastPage = { 0, 0 };
+        uint8_t lowKeys[256];
+        int glyphOffset = 0;
+        // 最后一页的 start + count 即总项数，用来定位偏移数组
+        fseek(binFile, indexStart + (long)((INDEX_PAGE_COUNT - 1) * sizeof(IndexPage)), SEEK_SET);
+        if (fread(&lastPage, sizeof(IndexPage), 1, binFile) != 1) {
+            fclose(binFile);
+            return 0;
+        }
+        fseek(binFile, indexStart + (long)((unicode >> 8) * sizeof(IndexPage)), SEEK_SET);
+        if (fread(&page, sizeof(IndexPage), 1, binFile) == 1 && page.count <= 256) {
+            fseek(binFile, indexStart + (long)(INDEX_PAGE_COUNT * sizeof(IndexPage) + page.start), SEEK_SET);
+            int k = fread(lowKeys, 1, page.count, binFile) == page.count ? findPageKey(lowKeys, page.count, (uint8_t)unicode) : -1;
+            if (k >= 0) {
+                int entries = lastPage.start + lastPage.count;
+                fseek(binFile, indexStart + (long)getIndexOffsetPosition(INDEX_LAYOUT_PAGED, entries, 0, page.start + k), SEEK_SET);
+                if (fread(&glyphOffset, sizeof(int), 1, binFile) != 1) glyphOffset = 0;
+            }
+        }
+        fclose(binFile);
+        return (glyphOffset & GLYPH_OFFSET_MISSING) ? 0 : glyphOffset;  // 缺字的码位按未找到处理
+    }
+    if (fontSetHeader.indexMethod == INDEX_METHOD_SORTED || fontSetHeader.indexLayout == INDEX_LAYOUT_SPLIT) {
+        long indexStart = ftell(binFile);
+        int layout = fontSetHeader.indexLayout;
+        int low = 0, high = indexEntries - 1;
+        while (low <= high) {
+            // 分离布局的无序索引逐个读取码位，等同于线性查找
+            int middle = fontSetHeader.indexMethod == INDEX_METHOD_SORTED ? low + (high - low) / 2 : low;
+            uint16_t currentUnicode;
+            int glyphOffset = 0;
+            fseek(binFile, indexStart + (long)getIndexKeyPosition(layout, middle), SEEK_SET);
+            if (fread(&currentUnicode, sizeof(uint16_t), 1, binFile) != 1) break;
+            if (currentUnicode < unicode || (currentUnicode != unicode && fontSetHeader.indexMethod != INDEX_METHOD_SORTED)) {
+                low = middle + 1;
+            } else if (currentUnicode > unicode) {
+                high = middle - 1;
+            } else {
+                fseek(binFile, indexStart + (long)getIndexOffsetPosition(layout, indexEntries, 0, middle), SEEK_SET);
+                if (fread(&glyphOffset, sizeof(int), 1, binFile) != 1) glyphOffset = 0;
+                fclose(binFile);
+                return (glyphOffset & GLYPH_OFFSET_MISSING) ? 0 : glyphOffset;  // 缺字的码位按未找到处理
+            }
+        }
+        fclose(binFile);
+        return 0;
+    }
+    for (int i = 0; i < indexEntries; ++i) {
+        uint16_t currentUnicode;
+        fread(&currentUnicode, sizeof(uint16_t), 1, binFile);
+
+        int glyphOffset;
+        fread(&glyphOffset, sizeof(int), 1, binFile);
+
+        if (currentUnicode == unicode) {
+            fclose(binFile);
+            return (glyphOffset & GLYPH_OFFSET_MISSING) ? 0 : glyphOffset;  // 缺字的码位按未找到处理
+        }
+    }
+
+    fclose(binFile);
+    return 0;
+}
+
+// 在内存中的 bin 数据里查找码位，header 为 parseBinHeader 解析出的头部。
+// 按 indexMethod 位和索引区布局选择查找方法，返回字形数据偏移，未找到或字体中缺失时返回 0
+int getGlyphOffsetFromHeader(uint16_t unicode, const uint8_t *mem, const FontSet *header) {
+    const uint8_t *ptr = mem + (uint8_t)header->length;
+    int layout = header->indexLayout;
+    int indexAreaSize = header->indexAreaSize;
+
+    int indexEntries = indexAreaSize / (sizeof(uint16_t) + sizeof(int));
+    int segmentCount = 0;
+    int entry;
+    if (layout == INDEX_LAYOUT_RANGES) {
+        indexEntries = getRangeIndexCounts(ptr, indexAreaSize, &segmentCount);
+        if (indexEntries < 0) return 0;
+        entry = findRangeSlot((const IndexRange *)(ptr + sizeof(uint32_t)), segmentCount, unicode);
+    } else if (layout == INDEX_LAYOUT_PAGED) {
+        indexEntries = getPagedIndexCount(ptr, indexAreaSize);
+        if (indexEntries < 0) return 0;
+        entry = findPagedSlot(ptr, unicode);
+    } else {
+        entry = findIndexEntry(ptr, getIndexKeyPosition(layout, 1), indexEntries, header->indexMethod, unicode);
+    }
+    if (entry < 0) return 0;
+
+    int glyphOffset;
+    memcpy(&glyphOffset, ptr + getIndexOffsetPosition(layout, indexEntries, segmentCount, entry), sizeof(int));
+    return (glyphOffset & GLYPH_OFFSET_MISSING) ? 0 : glyphOffset;  // 缺字的码位按未找到处理
+}
+
+// 模拟从内存中获取指定 Unicode 字符的字形数据偏移地址。
+// 每次调用都要解析头部，多次查找时先用 parseBinHeader 解析一次再调用 getGlyphOffsetFromHeader，或者用 mountBin
+int getGlyphOffsetFromMemory(uint16_t unicode, const uint8_t *mem) {
+    FontSet header;
+    if (parseBinHeaderFields(mem, SIZE_MAX, &header) < 0) return 0;
+    return getGlyphOffsetFromHeader(unicode, mem, &header);
+}
+
+// 逐点读取字形记录中的轮廓，不需要先展开成数组；各种轮廓编码格式都适用
+typedef struct {
+    const uint8_t *ptr;             // 下一个点的编码
+    const uint8_t *windingLengths;
+    const uint8_t *pointTypes;      // 仅曲线格式
+    int windingCount;
+    int winding;                    // 当前轮廓
+    int remaining;                  // 当前轮廓剩余的点数
+    int pointIndex;                 // 已读出的点数
+    int pointType;                  // 最近读出的点的 POINT_TYPE_*
+    int outlineFormat;
+    int quantBits;                  // 仅量化格式：坐标位数、已读的位数和包围盒
+    uint32_t bitPosition;
+    int box[4];
+    int x;
+    int y;
+} GlyphPointReader;
+
+// record 指向一条字形记录的开头，返回轮廓数；quantBits 只对量化格式有意义，见文件头的 quantBits
+int glyphPointReaderInit(GlyphPointReader *reader, const uint8_t *record, int outlineFormat, int quantBits) {
+    const size_t fixedLength = sizeof(short) * 5 + 1;
+    reader->windingCount = record[fixedLength - 1];
+    reader->windingLengths = record + fixedLength;
+    reader->ptr = reader->windingLengths + reader->windingCount;
+    reader->pointTypes = NULL;
+    if (outlineFormat == OUTLINE_FORMAT_CURVES) {
+        int pointCount = 0;
+        for (int i = 0; i < reader->windingCount; ++i) {
+            pointCount += reader->windingLengths[i];
+        }
+        reader->pointTypes = reader->ptr;
+        reader->ptr += (pointCount + 3) / 4;
+    }
+    reader->winding = -1;
+    reader->remaining = 0;
+    reader->pointIndex = 0;
+    reader->pointType = POINT_TYPE_ON;
+    reader->outlineFormat = outlineFormat;
+    reader->quantBits = quantBits;
+    reader->bitPosition = 0;
+    if (outlineFormat == OUTLINE_FORMAT_QUANTIZED) {
+        short box[4];
+        memcpy(box, record, sizeof(box));
+        reader->box[0] = box[0];
+        reader->box[1] = box[2] - box[0];
+        reader->box[2] = -box[3];
+        reader->box[3] = box[3] - box[1];
+    }
+    reader->x = 0;
+    reader->y = 0;
+    return reader->windingCount;
+}
+
+// 从 ptr 开始的位流中读出 bitPosition 处的 bits 位，低位在前
+static uint32_t readBits(const uint8_t *ptr, uint32_t bitPosition, int bits) {
+    uint32_t value = 0;
+    for (int got = 0; got < bits; ) {
+        uint32_t byte = ptr[(bitPosition + got) >> 3] >> ((bitPosition + got) & 7);
+        int take = 8 - (int)((bitPosition + got) & 7);
+        if (take > bits - got) take = bits - got;
+        value |= (byte & ((1u << take) - 1)) << got;
+        got += take;
+    }
+    return value;
+}
+
+static uint32_t readVarint(const uint8_t **ptr) {
+    const uint8_t *p = *ptr;
+    uint32_t value = 0;
+    int shift = 0;
+    do {
+        value |= (uint32_t)(*p & 0x7F) << shift;
+        shift += 7;
+    } while ((*p++ & 0x80) && shift < 35);
+    *ptr = p;
+    return value;
+}
+
+// 读出下一个点，返回该点所在轮廓的序号；所有点读完时返回 -1
+int glyphPointReaderNext(GlyphPointReader *reader, short *x, short *y) {
+    while (reader->remaining == 0) {
+        if (reader->winding + 1 >= reader->windingCount) return -1;
+        reader->winding++;
+        reader->remaining = reader->windingLengths[reader->winding];
+    }
+    reader->remaining--;
+    if (reader->pointTypes) {
+        reader->pointType = (reader->pointTypes[reader->pointIndex / 4] >> (reader->pointIndex % 4 * 2)) & 0x03;
+    }
+    reader->pointIndex++;
+
+    if (reader->outlineFormat == OUTLINE_FORMAT_QUANTIZED) {
+        int bits = reader->quantBits;
+        reader->x = dequantizeCoordinate(readBits(reader->ptr, reader->bitPosition, bits), reader->box[0], reader->box[1], bits);
+        reader->y = dequantizeCoordinate(readBits(reader->ptr, reader->bitPosition + bits, bits), reader->box[2], reader->box[3], bits);
+        reader->bitPosition += 2 * bits;
+    } else if (reader->outlineFormat != OUTLINE_FORMAT_RAW) {
+        reader->x = (short)(reader->x + zigzagDecode(readVarint(&reader->ptr)));
+        reader->y = (short)(reader->y + zigzagDecode(readVarint(&reader->ptr)));
+    } else {
+        short point[2];
+        memcpy(point, reader->ptr, sizeof(point));
+        reader->ptr += sizeof(point);
+        reader->x = point[0];
+        reader->y = point[1];
+    }
+    *x = (short)reader->x;
+    *y = (short)reader->y;
+    return reader->winding;
+}
+
+// 与 stbtt_ScaleForPixelHeight 相同：bin 中的坐标为字体单位，乘以该比例得到 pixelHeight 字号下的像素
+float getBinScaleForPixelHeight(const uint8_t *mem, float pixelHeight) {
+    short ascent, descent;
+    memcpy(&ascent, mem + 14, sizeof(short));
+    memcpy(&descent, mem + 16, sizeof(short));
+    return ascent > descent ? pixelHeight / (float)(ascent - descent) : 0;
+}
+
+// 曲线展平的分段数：弦与曲线的最大距离不超过 flatness 像素
+// deviation 为控制多边形的二阶差分长度（字体单位），二次曲线 factor 取 1/4，三次曲线取 3/4
+static int curveSegmentCount(float deviation, float scale, float flatness, float factor) {
+    int segments = (int)ceilf(sqrtf(deviation * scale * factor / flatness));
+    return segments < 1 ? 1 : segments > 255 ? 255 : segments;
+}
+
+// 展平曲线格式的一个轮廓，out 为空时只计算输出点数
+static int flattenCurveContour(const short *points, const uint8_t *types, int count, float scale, float flatness, short *out) {
+    if (count == 0) return 0;
+    if (out) {
+        out[0] = points[0];
+        out[1] = points[1];
+    }
+    int n = 1;
+    int pen[2] = { points[0], points[1] };
+    for (int i = 1; i < count; ) {
+        int p[8] = { pen[0], pen[1] };  // 起点、控制点、终点
+        int controls;
+        if (types[i] == POINT_TYPE_QUAD && i + 1 < count) {
+            controls = 1;
+            p[2] = points[2 * i];
+            p[3] = points[2 * i + 1];
+            if (types[i + 1] == POINT_TYPE_QUAD) {
+                // 隐含点，与 stbtt_GetGlyphShape 的计算方式相同
+                p[4] = (p[2] + points[2 * (i + 1)]) >> 1;
+                p[5] = (p[3] + points[2 * (i + 1) + 1]) >> 1;
+                i += 1;
+            } else {
+                p[4] = points[2 * (i + 1)];
+                p[5] = points[2 * (i + 1) + 1];
+                i += 2;
+            }
+        } else if (types[i] == POINT_TYPE_CUBIC && i + 2 < count) {
+            controls = 2;
+            for (int k = 0; k < 6; ++k) {
+                p[2 + k] = points[2 * i + k];
+            }
+            i += 3;
+        } else {
+            // 直线；控制点不完整的记录也按直线处理
+            pen[0] = points[2 * i];
+            pen[1] = points[2 * i + 1];
+            if (out) {
+                out[2 * n] = (short)pen[0];
+                out[2 * n + 1] = (short)pen[1];
+            }
+            n++;
+            i++;
+            continue;
+        }
+
+        float dx = (float)(p[0] - 2 * p[2] + p[4]);
+        float dy = (float)(p[1] - 2 * p[3] + p[5]);
+        float deviation = sqrtf(dx * dx + dy * dy);
+        if (controls == 2) {
+            float ex = (float)(p[2] - 2 * p[4] + p[6]);
+            float ey = (float)(p[3] - 2 * p[5] + p[7]);
+            float second = sqrtf(ex * ex + ey * ey);
+            if (second > deviation) deviation = second;
+        }
+        int segments = curveSegmentCount(deviation, scale, flatness, controls == 1 ? 0.25f : 0.75f);
+
+        if (out) {
+            for (int s = 1; s <= segments; ++s) {
+                float t = (float)s / segments, u = 1 - t;
+                float x, y;
+                if (controls == 1) {
+                    x = u * u * p[0] + 2 * u * t * p[2] + t * t * p[4];
+                    y = u * u * p[1] + 2 * u * t * p[3] + t * t * p[5];
+                } else {
+                    x = u * u * u * p[0] + 3 * u * u * t * p[2] + 3 * u * t * t * p[4] + t * t * t * p[6];
+                    y = u * u * u * p[1] + 3 * u * u * t * p[3] + 3 * u * t * t * p[5] + t * t * t * p[7];
+                }
+                out[2 * (n + s - 1)] = (short)floorf(x + 0.5f);
+                out[2 * (n + s - 1) + 1] = (short)floorf(y + 0.5f);
+            }
+        }
+        n += segments;
+        pen[0] = p[2 * (controls + 1)];
+        pen[1] = p[2 * (controls + 1) + 1];
+    }
+    return n;
+}
+
+// 渲染时展平曲线格式的字形记录：每段曲线按实际缩放比例 scale（见 getBinScaleForPixelHeight）
+// 选择分段数，误差不超过 flatness 像素；结果为字体单位的折线，格式与原始格式的 readFontGlyphData 相同，
+// 超过 255 个点的折线和生成时一样拆成首尾相接的几段
+int flattenGlyphRecord(const uint8_t *record, float scale, float flatness, FontGlyphData *glyphData) {
+    short header[5];
+    memcpy(header, record, sizeof(header));
+    glyphData->sx0 = header[0];
+    glyphData->sy0 = header[1];
+    glyphData->sx1 = header[2];
+    glyphData->sy1 = header[3];
+    glyphData->advance = header[4];
+    glyphData->winding_lengths = NULL;
+    glyphData->windings = NULL;
+    if (flatness <= 0) flatness = 1.0f;
+
+    GlyphPointReader reader;
+    int contourCount = glyphPointReaderInit(&reader, record, OUTLINE_FORMAT_CURVES, 0);
+    int pointCount = 0;
+    for (int i = 0; i < contourCount; ++i) {
+        pointCount += reader.windingLengths[i];
+    }
+
+    short *points = (short *)malloc((pointCount > 0 ? pointCount : 1) * 2 * sizeof(short));
+    uint8_t *types = (uint8_t *)malloc(pointCount > 0 ? pointCount : 1);
+    int *flatLengths = (int *)malloc((contourCount > 0 ? contourCount : 1) * sizeof(int));
+    short *flat = NULL;
+    if (!points || !types || !flatLengths) goto fail;
+    for (int i = 0; glyphPointReaderNext(&reader, &points[2 * i], &points[2 * i + 1]) >= 0; ++i) {
+        types[i] = (uint8_t)reader.pointType;
+    }
+
+    int flatCount = 0;
+    for (int c = 0, first = 0; c < contourCount; first += reader.windingLengths[c++]) {
+        flatLengths[c] = flattenCurveContour(&points[2 * first], &types[first], reader.windingLengths[c], scale, flatness, NULL);
+        flatCount += flatLengths[c];
+    }
+    flat = (short *)malloc((flatCount > 0 ? flatCount : 1) * 2 * sizeof(short));
+    if (!flat) goto fail;
+    for (int c = 0, first = 0, written = 0; c < contourCount; written += flatLengths[c], first += reader.windingLengths[c++]) {
+        flattenCurveContour(&points[2 * first], &types[first], reader.windingLengths[c], scale, flatness, &flat[2 * written]);
+    }
+
+    // 每段最多 255 个点，相邻两段共用断开处的点
+    int windingCount = 0;
+    for (int c = 0; c < contourCount; ++c) {
+        windingCount += flatLengths[c] > 255 ? (flatLengths[c] - 2) / 254 + 1 : 1;
+    }
+    if (windingCount > 255) {
+        fprintf(stderr, "Too many windings in flattened glyph!\n");
+        goto fail;
+    }
+    glyphData->winding_count = (uint8_t)windingCount;
+    glyphData->winding_lengths = (uint8_t *)malloc(windingCount > 0 ? windingCount : 1);
+    glyphData->windings = (short *)malloc((flatCount + windingCount) * 2 * sizeof(short));
+    if (!glyphData->winding_lengths || !glyphData->windings) goto fail;
+
+    short *out = glyphData->windings;
+    int winding = 0;
+    for (int c = 0, first = 0; c < contourCount; first += flatLengths[c++]) {
+        for (int position = 0; ; position += 254) {
+            int length = flatLengths[c] - position > 255 ? 255 : flatLengths[c] - position;
+            memcpy(out, &flat[2 * (first + position)], length * 2 * sizeof(short));
+            out += length * 2;
+            glyphData->winding_lengths[winding++] = (uint8_t)length;
+            if (position + length == flatLengths[c]) break;
+        }
+    }
+
+    free(points);
+    free(types);
+    free(flatLengths);
+    free(flat);
+    return 0;
+
+fail:
+    fprintf(stderr, "Failed to flatten glyph record!\n");
+    free(points);
+    free(types);
+    free(flatLengths);
+    free(flat);
+    free(glyphData->winding_lengths);
+    free(glyphData->windings);
+    return -1;
+}
+
+// 边表格式的字形记录中的边数，record 指向记录开头
+int getGlyphEdgeCount(const uint8_t *record) {
+    uint16_t edgeCount;
+    memcpy(&edgeCount, record + sizeof(short) * 5, sizeof(uint16_t));
+    return edgeCount;
+}
+
+// 读出边表格式记录中的第 index 条边；记录没有对齐要求，逐条拷贝出来
+void readGlyphEdge(const uint8_t *record, int index, GlyphEdge *edge) {
+    memcpy(edge, record + sizeof(short) * 5 + sizeof(uint16_t) + (size_t)index * sizeof(GlyphEdge), sizeof(GlyphEdge));
+}
+
+// 读取 bin 数据 mem 中 offset 处的字形记录，fontSet 为 parseBinHeader 解析出的头部，轮廓点按其中的编码格式解码为 short 数组
+// 曲线格式按文件头的字号和渲染模式展平，精度与生成原始格式时相同；其他字号用 flattenGlyphRecord
+int readFontGlyphDataFromHeader(const uint8_t *mem, const FontSet *fontSet, int offset, FontGlyphData *glyphData) {
+    const uint8_t *ptr = mem + offset;
+    int outlineFormat = fontSet->rsvd & OUTLINE_FORMAT_MASK;
+    if (outlineFormat == OUTLINE_FORMAT_CURVES) {
+        int renderMode = (uint8_t)fontSet->renderMode;
+        return flattenGlyphRecord(ptr, getBinScaleForPixelHeight(mem, (uint8_t)fontSet->fontSize), 1.0f / (renderMode ? renderMode : 1), glyphData);
+    }
+    if (outlineFormat == OUTLINE_FORMAT_EDGES) {
+        fprintf(stderr, "Edge table records have no contour points, use readGlyphEdge!\n");
+        return -1;
+    }
+
+    // 读取基本的坐标和计数：5 个 short 加 1 字节轮廓数，记录中没有结构体的对齐填充
+    short header[5];
+    memcpy(header, ptr, sizeof(header));
+    glyphData->sx0 = header[0];
+    glyphData->sy0 = header[1];
+    glyphData->sx1 = header[2];
+    glyphData->sy1 = header[3];
+    glyphData->advance = header[4];
+    glyphData->winding_count = ptr[sizeof(header)];
+    ptr += sizeof(header) + 1;
+
+    // 分配并读取 winding_lengths
+    glyphData->winding_lengths = (uint8_t *)malloc(glyphData->winding_count * sizeof(uint8_t));
+    if (!glyphData->winding_lengths) {
+        fprintf(stderr, "Memory allocation failed for winding_lengths!\n");
+        return -1;
+    }
+    memcpy(glyphData->winding_lengths, ptr, glyphData->winding_count);
+
+    // 计算线条数量
+    int line_count = 0;
+    for (int i = 0; i < glyphData->winding_count; ++i) {
+        line_count += glyphData->winding_lengths[i];
+    }
+
+    // 分配并读取 windings
+    glyphData->windings = (short *)malloc((line_count > 0 ? line_count : 1) * 2 * sizeof(short));
+    if (!glyphData->windings) {
+        fprintf(stderr, "Memory allocation failed for windings!\n");
+        free(glyphData->winding_lengths);
+        return -1;
+    }
+
+    GlyphPointReader reader;
+    glyphPointReaderInit(&reader, mem + offset, outlineFormat, fontSet->quantBits);
+    for (int i = 0; glyphPointReaderNext(&reader, &glyphData->windings[2 * i], &glyphData->windings[2 * i + 1]) >= 0; ++i) {
+    }
+
+    return 0; // 成功
+}
+
+// 同 readFontGlyphDataFromHeader，每次调用都重新解析 mem 的头部
+int readFontGlyphData(const uint8_t *mem, int offset, FontGlyphData *glyphData) {
+    FontSet header;
+    if (parseBinHeaderFields(mem, SIZE_MAX, &header) < 0) {
+        fprintf(stderr, "Invalid BIN header!\n");
+        return -1;
+    }
+    return readFontGlyphDataFromHeader(mem, &header, offset, glyphData);
+}
+
+// offset 处完整字形记录的字节数，记录超出 size 或格式未知时返回 -1
+int getGlyphRecordSize(const uint8_t *mem, size_t size, size_t offset, int outlineFormat, int quantBits) {
+    const size_t fixedLength = sizeof(short) * 5 + 1;
+    if (offset > size || size - offset < fixedLength) return -1;
+
+    const uint8_t *ptr = mem + offset;
+    if (outlineFormat == OUTLINE_FORMAT_EDGES) {
+        // 包围盒、advance 之后是 u16 边数，没有轮廓数和轮廓点数
+        uint16_t edgeCount;
+        if (size - offset < fixedLength + 1) return -1;
+        memcpy(&edgeCount, ptr + fixedLength - 1, sizeof(uint16_t));
+        size_t recordSize = fixedLength - 1 + sizeof(uint16_t) + (size_t)edgeCount * sizeof(GlyphEdge);
+        if (size - offset < recordSize) return -1;
+        return (int)recordSize;
+    }
+    uint8_t winding_count = ptr[fixedLength - 1];
+    if (size - offset < fixedLength + winding_count) return -1;
+
+    size_t pointCount = 0;
+    for (int i = 0; i < winding_count; ++i) {
+        pointCount += ptr[fixedLength + i];
+    }
+
+    size_t recordSize = fixedLength + winding_count;
+    if (outlineFormat == OUTLINE_FORMAT_RAW) {
+        recordSize += pointCount * 2 * sizeof(short);
+    } else if (outlineFormat == OUTLINE_FORMAT_QUANTIZED) {
+        if (quantBits < QUANT_BITS_MIN || quantBits > QUANT_BITS_MAX) return -1;
+        recordSize += (pointCount * 2 * quantBits + 7) / 8;
+    } else if (outlineFormat == OUTLINE_FORMAT_DELTA || outlineFormat == OUTLINE_FORMAT_CURVES) {
+        if (outlineFormat == OUTLINE_FORMAT_CURVES) {
+            recordSize += (pointCount + 3) / 4;  // 点类型
+        }
+        // 每个分量一个 varint，最后一个字节的最高位为 0
+        for (size_t values = pointCount * 2; values > 0; --values) {
+            size_t bytes = 0;
+            do {
+                if (offset + recordSize + bytes >= size || bytes == 3) return -1;
+            } while (mem[offset + recordSize + bytes++] & 0x80);
+            recordSize += bytes;
+        }
+    } else {
+        return -1;
+    }
+    if (size - offset < recordSize) return -1;
+    return (int)recordSize;
+}
+
+// 挂载选项
+#define MOUNT_VERIFY_CHECKSUM  1  // 文件带校验和时校验
+#define MOUNT_REQUIRE_CHECKSUM 2  // 文件不带校验和时拒绝挂载
+
+// 挂载后的 bin 文件。mountBin 一次性检查校验和、头部、索引区以及每个索引项指向的字形记录，
+// 挂载成功后查询和读取字形不再需要逐次做边界检查
+typedef struct {
+    const uint8_t *data;
+    size_t size;             // 有效长度，不含校验和尾部
+    FontSet header;          // header.fontName 由 unmountBin 释放
+    const uint8_t *index;    // 第一项的码位
+    const uint8_t *offsets;  // 第一项的偏移
+    int keyStride;           // 相邻项的码位、偏移之间的字节数，取决于 header.indexLayout；分段布局没有码位数组，为 0
+    int offsetStride;
+    const IndexRange *ranges;  // 仅分段布局
+    int rangeCount;
+    const uint8_t *pages;    // 仅两级索引布局：页表，其后是各项码位的低字节
+    int entryCount;
+    int hasChecksum;
+    MappedFile file;         // 由 mountBinFile 映射时有效
+} MountedBin;
+
+void unmountBin(MountedBin *bin) {
+    free(bin->header.fontName);
+    unmapFile(&bin->file);
+    memset(bin, 0, sizeof(MountedBin));
+}
+
+// 挂载内存中的 bin 数据，data 在挂载期间必须保持有效。flags 为 MOUNT_* 的组合
+int mountBin(MountedBin *bin, const uint8_t *data, size_t size, int flags) {
+    memset(bin, 0, sizeof(MountedBin));
+
+    int checksum = verifyBinChecksum(data, size);
+    if (checksum < 0 && (flags & (MOUNT_VERIFY_CHECKSUM | MOUNT_REQUIRE_CHECKSUM))) {
+        fprintf(stderr, "BIN checksum mismatch or file truncated!\n");
+        return -1;
+    }
+    if (checksum == 0 && (flags & MOUNT_REQUIRE_CHECKSUM)) {
+        fprintf(stderr, "BIN file has no checksum!\n");
+        return -1;
+    }
+
+    bin->hasChecksum = checksum != 0;
+    bin->data = data;
+    bin->size = bin->hasChecksum ? size - CHECKSUM_TRAILER_SIZE : size;
+
+    int indexStart = parseBinHeader(data, bin->size, &bin->header);
+    int layout = bin->header.indexLayout;
+    int entryCount = -1, segmentCount = 0;
+    if (indexStart >= 0) {
+        entryCount = getIndexEntryCount(layout, data + indexStart, bin->header.indexAreaSize, &segmentCount);
+    }
+    if (indexStart < 0 || entryCount < 0 || bin->header.indexAreaSize != getIndexAreaSize(layout, entryCount, segmentCount)) {
+        fprintf(stderr, "Invalid BIN header!\n");
+        if (indexStart >= 0) free(bin->header.fontName);
+        memset(bin, 0, sizeof(MountedBin));
+        return -1;
+    }
+    bin->entryCount = entryCount;
+    bin->index = data + indexStart;
+    bin->offsets = bin->index + getIndexOffsetPosition(layout, entryCount, segmentCount, 0);
+    bin->keyStride = layout == INDEX_LAYOUT_RANGES || layout == INDEX_LAYOUT_PAGED ? 0 : (int)getIndexKeyPosition(layout, 1);
+    bin->offsetStride = (int)(getIndexOffsetPosition(layout, entryCount, segmentCount, 1) - getIndexOffsetPosition(layout, entryCount, segmentCount, 0));
+
+    // 分段布局的段必须升序、互不重叠，并且依次覆盖全部偏移
+    if (layout == INDEX_LAYOUT_RANGES) {
+        bin->ranges = (const IndexRange *)(bin->index + sizeof(uint32_t));
+        bin->rangeCount = segmentCount;
+        uint32_t nextStart = 0, slot = 0;
+        for (int j = 0; j < segmentCount; ++j) {
+            const IndexRange *range = &bin->ranges[j];
+            if (range->count == 0 || range->start < nextStart || range->firstSlot != slot) {
+                fprintf(stderr, "Invalid range %d in BIN index!\n", j);
+                free(bin->header.fontName);
+                memset(bin, 0, sizeof(MountedBin));
+                return -1;
+            }
+            nextStart = (uint32_t)range->start + range->count;
+            slot += range->count;
+        }
+        if (slot != (uint32_t)entryCount || nextStart > 0x10000) {
+            fprintf(stderr, "BIN index ranges do not cover %d entries!\n", entryCount);
+            free(bin->header.fontName);
+            memset(bin, 0, sizeof(MountedBin));
+            return -1;
+        }
+    }
+
+    // 两级索引的页已由 getPagedIndexCount 检查为依次相接，页内低字节还必须严格升序
+    if (layout == INDEX_LAYOUT_PAGED) {
+        bin->pages = bin->index;
+        const IndexPage *pages = (const IndexPage *)bin->pages;
+        const uint8_t *lowKeys = bin->pages + INDEX_PAGE_COUNT * sizeof(IndexPage);
+        for (int page = 0; page < INDEX_PAGE_COUNT; ++page) {
+            for (int k = 1; k < pages[page].count; ++k) {
+                if (lowKeys[pages[page].start + k - 1] >= lowKeys[pages[page].start + k]) {
+                    fprintf(stderr, "Invalid page 0x%02X in BIN index!\n", page);
+                    free(bin->header.fontName);
+                    memset(bin, 0, sizeof(MountedBin));
+                    return -1;
+                }
+            }
+        }
+    }
+
+    // 每个索引项（包括指向共享缺字记录的项）都必须指向索引区之后的一条完整记录；
+    // MISSING_GLYPH_EMPTY 生成的文件中，排在最后的缺字项指向字形数据末尾，也允许；
+    // 标记为有序的索引还必须严格升序，否则二分查找会漏掉字形
+    size_t glyphStart = (size_t)indexStart + bin->header.indexAreaSize;
+    for (int i = 0; i < bin->entryCount; ++i) {
+        if (bin->header.indexMethod == INDEX_METHOD_SORTED && bin->keyStride && i > 0) {
+            uint16_t previous, current;
+            memcpy(&previous, bin->index + (size_t)(i - 1) * bin->keyStride, sizeof(uint16_t));
+            memcpy(&current, bin->index + (size_t)i * bin->keyStride, sizeof(uint16_t));
+            if (previous >= current) {
+                fprintf(stderr, "BIN index is marked sorted but 0x%04X follows 0x%04X!\n", current, previous);
+                free(bin->header.fontName);
+                memset(bin, 0, sizeof(MountedBin));
+                return -1;
+            }
+        }
+        uint32_t offset;
+        memcpy(&offset, bin->offsets + (size_t)i * bin->offsetStride, sizeof(uint32_t));
+        offset &= GLYPH_OFFSET_MASK;
+        if (offset == bin->size && offset >= glyphStart) continue;
+        if (offset < glyphStart || getGlyphRecordSize(data, bin->size, offset, bin->header.rsvd & OUTLINE_FORMAT_MASK, bin->header.quantBits) < 0) {
+            fprintf(stderr, "Invalid glyph offset 0x%08X in BIN index!\n", offset);
+            free(bin->header.fontName);
+            memset(bin, 0, sizeof(MountedBin));
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// 映射并挂载 bin 文件，用 unmountBin 释放
+int mountBinFile(MountedBin *bin, const char *path, int flags) {
+    MappedFile file;
+    if (mapFileReadOnly(path, &file) != 0) {
+        return -1;
+    }
+    if (mountBin(bin, file.data, file.size, flags) != 0) {
+        fprintf(stderr, "Failed to mount BIN file %s!\n", path);
+        unmapFile(&file);
+        return -1;
+    }
+    bin->file = file;
+    return 0;
+}
+
+// 已挂载 bin 中码位对应的字形记录偏移，未找到或字体中缺失时返回 0
+int mountedBinFindGlyph(const MountedBin *bin, uint16_t unicode) {
+    int entry = bin->ranges ? findRangeSlot(bin->ranges, bin->rangeCount, unicode)
+              : bin->pages  ? findPagedSlot(bin->pages, unicode)
+                            : findIndexEntry(bin->index, bin->keyStride, bin->entryCount, bin->header.indexMethod, unicode);
+    if (entry < 0) return 0;
+
+    uint32_t offset;
+    memcpy(&offset, bin->offsets + (size_t)entry * bin->offsetStride, sizeof(uint32_t));
+    return (offset & GLYPH_OFFSET_MISSING) || offset == bin->size ? 0 : (int)offset;
+}
+
+// 模拟从文件读取整个文件到内存中
+uint8_t* loadFileToMemory(const char *filePath, int *length) {
+    FILE *file = fopen(filePath, "rb");
+    if (!file) {
+        fprintf(stderr, "Error opening file %s!\n", filePath);
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    *length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    uint8_t *buffer = (uint8_t*)malloc(*length);
+    if (!buffer) {
+        fprintf(stderr, "Memory allocation failed!\n");
+        fclose(file);
+        return NULL;
+    }
+
+    fread(buffer, 1, *length, file);
+    fclose(file);
+
+    return buffer;
+}
+
+// 读取整个文本文件并以 '\0' 结尾，用于加载字符集文件
+char *loadTextFile(const char *filePath) {
+    int length = 0;
+    uint8_t *data = loadFileToMemory(filePath, &length);
+    if (!data) return NULL;
+
+    char *text = (char *)realloc(data, length + 1);
+    if (!text) {
+        free(data);
+        return NULL;
+    }
+    text[length] = '\0';
+    return text;
+}
+
+// 把字符集按升序写成 UTF-8 文本文件，可直接作为清单中的字符集文件使用
+int charsetSaveUtf8(const Charset *set, const char *path) {
+    uint16_t *codepoints;
+    int count = charsetToArray(set, &codepoints);
+    if (count < 0) return -1;
+
+    OutputBuffer out;
+    outputBufferInit(&out, (size_t)count * 3);
+    for (int i = 0; i < count; ++i) {
+        uint16_t c = codepoints[i];
+        uint8_t bytes[3];
+        size_t length;
+        if (c < 0x80) {
+            bytes[0] = (uint8_t)c;
+            length = 1;
+        } else if (c < 0x800) {
+            bytes[0] = (uint8_t)(0xC0 | (c >> 6));
+            bytes[1] = (uint8_t)(0x80 | (c & 0x3F));
+            length = 2;
+        } else {
+            bytes[0] = (uint8_t)(0xE0 | (c >> 12));
+            bytes[1] = (uint8_t)(0x80 | ((c >> 6) & 0x3F));
+            bytes[2] = (uint8_t)(0x80 | (c & 0x3F));
+            length = 3;
+        }
+        outputBufferWrite(&out, bytes, length);
+    }
+    free(codepoints);
+
+    int result = outputBufferSaveToFile(&out, path);
+    outputBufferFree(&out);
+    return result;
+}
+
+// 语料扫描：并行遍历目录树中的文本文件，分块流式解码 UTF-8，
+// 每个线程维护自己的字符集位图，最后按位或合并
+typedef struct {
+    char **paths;
+    int count;
+    int capacity;
+} PathList;
+
+static int pathListAppend(PathList *list, const char *path) {
+    if (list->count == list->capacity) {
+        int newCapacity = list->capacity ? list->capacity * 2 : 256;
+        char **newPaths = (char **)realloc(list->paths, newCapacity * sizeof(char *));
+        if (!newPaths) return -1;
+        list->paths = newPaths;
+        list->capacity = newCapacity;
+    }
+    list->paths[list->count] = strdup(path);
+    if (!list->paths[list->count]) return -1;
+    list->count++;
+    return 0;
+}
+
+void pathListFree(PathList *list) {
+    for (int i = 0; i < list->count; ++i) {
+        free(list->paths[i]);
+    }
+    free(list->paths);
+    memset(list, 0, sizeof(PathList));
+}
+
+// extensions 为逗号分隔的扩展名列表（如 ".txt,.json"），为空时接受所有文件
+static int matchesExtension(const char *path, const char *extensions) {
+    if (!extensions || !*extensions) return 1;
+
+    const char *dot = strrchr(path, '.');
+    if (!dot) return 0;
+    size_t dotLength = strlen(dot);
+
+    const char *p = extensions;
+    while (*p) {
+        const char *comma = strchr(p, ',');
+        size_t length = comma ? (size_t)(comma - p) : strlen(p);
+        if (length == dotLength && strncmp(dot, p, length) == 0) return 1;
+        if (!comma) break;
+        p = comma + 1;
+    }
+    return 0;
+}
+
+// 递归收集 root 下的文件，跳过以 '.' 开头的文件和目录（如 .git）；root 本身是文件时直接加入
+int collectCorpusFiles(const char *root, const char *extensions, PathList *list) {
+    char path[1024];
+
+#ifdef _WIN32
+    DWORD attributes = GetFileAttributesA(root);
+    if (attributes == INVALID_FILE_ATTRIBUTES) {
+        fprintf(stderr, "Error opening %s!\n", root);
+        return -1;
+    }
+    if (!(attributes & FILE_ATTRIBUTE_DIRECTORY)) {
+        return pathListAppend(list, root);
+    }
+
+    WIN32_FIND_DATAA findData;
+    snprintf(path, sizeof(path), "%s\\*", root);
+    HANDLE find = FindFirstFileA(path, &findData);
+    if (find == INVALID_HANDLE_VALUE) return 0;
+    int result = 0;
+    do {
+        if (findData.cFileName[0] == '.') continue;
+        snprintf(path, sizeof(path), "%s\\%s", root, findData.cFileName);
+        if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            result = collectCorpusFiles(path, extensions, list);
+        } else if (matchesExtension(path, extensions)) {
+            result = pathListAppend(list, path);
+        }
+    } while (result == 0 && FindNextFileA(find, &findData));
+    FindClose(find);
+    return result;
+#else
+    struct stat st;
+    if (stat(root, &st) != 0) {
+        fprintf(stderr, "Error opening %s!\n", root);
+        return -1;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        return pathListAppend(list, root);
+    }
+
+    DIR *dir = opendir(root);
+    if (!dir) return 0;
+    int result = 0;
+    struct dirent *entry;
+    while (result == 0 && (entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.') continue;
+        snprintf(path, sizeof(path), "%s/%s", root, entry->d_name);
+        if (stat(path, &st) != 0) continue;
+        if (S_ISDIR(st.st_mode)) {
+            result = collectCorpusFiles(path, extensions, list);
+        } else if (S_ISREG(st.st_mode) && matchesExtension(path, extensions)) {
+            result = pathListAppend(list, path);
+        }
+    }
+    closedir(dir);
+    return result;
+#endif
+}
+
+typedef struct {
+    long files;
+    long unreadable;
+    long long bytes;
+    long invalidSequences;
+    long supplementary;
+} CorpusScanStats;
+
+#define CORPUS_CHUNK_SIZE (64 * 1024)
+
+typedef struct {
+    const PathList *files;
+    int *nextFile;
+    Mutex *lock;
+    Charset set;
+    CorpusScanStats stats;
+} CorpusScanWorker;
+
+void scanCorpusFiles(void *arg) {
+    CorpusScanWorker *worker = (CorpusScanWorker *)arg;
+    uint8_t *chunk = (uint8_t *)malloc(CORPUS_CHUNK_SIZE);
+    if (!chunk) return;
+
+    for (;;) {
+        mutexLock(worker->lock);
+        int fileIndex = (*worker->nextFile)++;
+        mutexUnlock(worker->lock);
+        if (fileIndex >= worker->files->count) break;
+
+        FILE *file = fopen(worker->files->paths[fileIndex], "rb");
+        if (!file) {
+            worker->stats.unreadable++;
+            continue;
+        }
+
+        Utf8Decoder decoder;
+        utf8DecoderInit(&decoder);
+        size_t length;
+        while ((length = fread(chunk, 1, CORPUS_CHUNK_SIZE, file)) > 0) {
+            utf8DecodeChunk(&decoder, chunk, length, &worker->set);
+            worker->stats.bytes += length;
+        }
+        utf8DecoderFinish(&decoder);
+        fclose(file);
+
+        worker->stats.files++;
+        worker->stats.invalidSequences += decoder.invalidCount;
+        worker->stats.supplementary += decoder.supplementaryCount;
+    }
+
+    free(chunk);
+}
+
+// 扫描 roots 中的所有文件（目录递归展开），把出现过的 BMP 字符并入 result
+int scanCorpus(const char *const *roots, int rootCount, const char *extensions, int threadCount, Charset *result, CorpusScanStats *stats) {
+    PathList files = { NULL, 0, 0 };
+    for (int i = 0; i < rootCount; ++i) {
+        if (collectCorpusFiles(roots[i], extensions, &files) != 0) {
+            pathListFree(&files);
+            return -1;
+        }
+    }
+
+    if (threadCount <= 0) threadCount = getCpuCount();
+    if (threadCount > files.count) threadCount = files.count > 0 ? files.count : 1;
+
+    CorpusScanWorker *workers = (CorpusScanWorker *)calloc(threadCount, sizeof(CorpusScanWorker));
+    if (!workers) {
+        fprintf(stderr, "Memory allocation error for corpus scan!\n");
+        pathListFree(&files);
+        return -1;
+    }
+
+    Mutex lock;
+    int nextFile = 0;
+    mutexInit(&lock);
+    for (int t = 0; t < threadCount; ++t) {
+        workers[t].files = &files;
+        workers[t].nextFile = &nextFile;
+        workers[t].lock = &lock;
+    }
+
+    runParallel(scanCorpusFiles, workers, sizeof(CorpusScanWorker), threadCount);
+
+    memset(stats, 0, sizeof(CorpusScanStats));
+    for (int t = 0; t < threadCount; ++t) {
+        charsetUnion(result, &workers[t].set);
+        stats->files += workers[t].stats.files;
+        stats->unreadable += workers[t].stats.unreadable;
+        stats->bytes += workers[t].stats.bytes;
+        stats->invalidSequences += workers[t].stats.invalidSequences;
+        stats->supplementary += workers[t].stats.supplementary;
+    }
+
+    mutexDestroy(&lock);
+    free(workers);
+    pathListFree(&files);
+    return 0;
+}
+
+void printCorpusScanStats(const char *name, const Charset *set, const CorpusScanStats *stats) {
+    printf("[scan] %s: %ld files, %lld bytes, %d characters, %ld invalid sequences, %ld non-BMP skipped, %ld unreadable\n",
+           name, stats->files, stats->bytes, charsetCount(set), stats->invalidSequences, stats->supplementary, stats->unreadable);
+}
+
+// 批量任务共享的字体：每个 TTF 只映射、解析一次，之后所有任务只读共享同一份映射
+typedef struct {
+    char *path;
+    const unsigned char *data;
+    size_t size;
+    MappedFile file;  // 由 loadFontFile 映射时有效，freeLoadedFont 负责解除映射
+    uint64_t hash;    // TTF 内容哈希，用作字形缓存键
+    stbtt_fontinfo info;
+    GlyphLookup lookup;  // 码位→字形表，所有任务共享
+} LoadedFont;
+
+// 用调用方持有的内存 TTF 数据初始化字体，data 在字体使用期间必须保持有效
+int initLoadedFont(LoadedFont *font, const char *name, const unsigned char *data, size_t size) {
+    memset(font, 0, sizeof(LoadedFont));
+
+    int fontOffset = size >= 12 ? stbtt_GetFontOffsetForIndex(data, 0) : -1;
+    if (fontOffset < 0 || !stbtt_InitFont(&font->info, data, fontOffset)) {
+        fprintf(stderr, "Failed to initialize font %s!\n", name ? name : "");
+        return -1;
+    }
+
+    if (glyphLookupBuild(&font->lookup, &font->info) != 0) {
+        return -1;
+    }
+
+    font->path = strdup(name ? name : "");
+    font->data = data;
+    font->size = size;
+    font->hash = hashBytes(data, size, 0);
+    return 0;
+}
+
+int loadFontFile(LoadedFont *font, const char *ttfPath) {
+    MappedFile file;
+    if (mapFileReadOnly(ttfPath, &file) != 0) return -1;
+
+    if (initLoadedFont(font, ttfPath, file.data, file.size) != 0) {
+        unmapFile(&file);
+        return -1;
+    }
+    font->file = file;
+    return 0;
+}
+
+void freeLoadedFont(LoadedFont *font) {
+    free(font->path);
+    glyphLookupFree(&font->lookup);
+    unmapFile(&font->file);
+    memset(font, 0, sizeof(LoadedFont));
+}
+
+static int compareGlyphEntry(const void *a, const void *b) {
+    return (int)((const GlyphEntry *)a)->unicode - (int)((const GlyphEntry *)b)->unicode;
+}
+
+// 增量更新：读取已有 bin 文件，新字符集中已存在的字形按字节原样复用，只提取新增的字形，
+// 然后写出重新排序的索引。fontSet 为空时沿用旧文件头部的参数；
+// 返回 0 成功，1 表示旧文件与当前参数或字体不一致（需要全量生成），-1 表示出错。
+// codepoints 为新字符集，须升序、去重
+int updateBinFileFromCodepoints(const stbtt_fontinfo *font, const char *oldBinPath, const char *newBinPath,
+                                const uint16_t *codepoints, int count, FontSet *fontSet, const GenerateOptions *options) {
+    MappedFile oldBin;
+    if (mapFileReadOnly(oldBinPath, &oldBin) != 0) {
+        return -1;
+    }
+
+    FontSet oldHeader;
+    int indexStart = parseBinHeader(oldBin.data, oldBin.size, &oldHeader);
+    if (indexStart < 0) {
+        fprintf(stderr, "Invalid BIN file %s!\n", oldBinPath);
+        unmapFile(&oldBin);
+        return -1;
+    }
+
+    // 复用的记录必须和新提取的记录使用同一种轮廓编码：未指定参数时沿用旧文件的编码
+    int oldFormat = oldHeader.rsvd & OUTLINE_FORMAT_MASK;
+    GenerateOptions updateOptions = *options;
+    FontSet header = oldHeader;
+    if (fontSet) {
+        header = *fontSet;
+        if (header.fontSize != oldHeader.fontSize || header.renderMode != oldHeader.renderMode ||
+            header.bold != oldHeader.bold || header.italic != oldHeader.italic ||
+            header.scanMode != oldHeader.scanMode || header.indexMethod != oldHeader.indexMethod ||
+            options->outlineFormat != oldFormat ||
+            (oldFormat == OUTLINE_FORMAT_QUANTIZED && options->quantBits != oldHeader.quantBits) ||
+            effectiveFixedPointBits(options) != oldHeader.fixedPointBits) {
+            free(oldHeader.fontName);
+            unmapFile(&oldBin);
+            return 1;
+        }
+    }
+
+    int nameLength;
+    const char *name = getFontName(font, &nameLength);
+    int sameFont = nameLength == oldHeader.fontNameLength && memcmp(name, oldHeader.fontName, nameLength) == 0;
+    free(oldHeader.fontName);
+    updateOptions.outlineFormat = oldFormat;
+    if (oldFormat == OUTLINE_FORMAT_QUANTIZED) updateOptions.quantBits = oldHeader.quantBits;
+    updateOptions.fixedPointBits = oldHeader.fixedPointBits;
+    if (!fontSet) updateOptions.indexLayout = oldHeader.indexLayout;  // 索引布局不影响字形记录，只在未指定参数时沿用
+    if (!fontSet && (oldHeader.rsvd & FONTSET_FLAG_CHECKSUM)) updateOptions.checksum = 1;  // 同样沿用旧文件的校验和
+    if (!sameFont) {
+        unmapFile(&oldBin);
+        return 1;
+    }
+    // 字体名相同不代表轮廓相同：只有旧文件记录的内容哈希与当前 TTF 一致时才复用字形记录
+    int sameContent = oldHeader.fontHash != 0 && oldHeader.fontHash == options->fontHash;
+    // 简化容差同样决定记录内容，不沿用旧文件的容差：未指定时按不简化处理
+    int sameTolerance = effectiveSimplifyTolerance(&updateOptions) == oldHeader.simplifyTolerance;
+    if ((!sameContent || !sameTolerance) && fontSet) {
+        unmapFile(&oldBin);
+        return 1;
+    }
+    if (!sameContent) {
+        printf("[update] %s: font hash missing or changed, re-extracting all glyphs\n", oldBinPath);
+    } else if (!sameTolerance) {
+        printf("[update] %s: simplify tolerance %g differs from %g, re-extracting all glyphs\n",
+               oldBinPath, effectiveSimplifyTolerance(&updateOptions), oldHeader.simplifyTolerance);
+    }
+    int reuseRecords = sameContent && sameTolerance;
+    updateOptions.recordFontHash = 1;  // 输出写入内容哈希，供下一次增量更新确认
+
+    const uint8_t *indexPtr = oldBin.data + indexStart;
+    int oldSegmentCount = 0;
+    int oldCount = getIndexEntryCount(oldHeader.indexLayout, indexPtr, oldHeader.indexAreaSize, &oldSegmentCount);
+    if (oldCount < 0) {
+        fprintf(stderr, "Invalid BIN file %s!\n", oldBinPath);
+        unmapFile(&oldBin);
+        return -1;
+    }
+    GlyphEntry *oldEntries = (GlyphEntry *)malloc((oldCount > 0 ? oldCount : 1) * sizeof(GlyphEntry));
+    GlyphRecordRef *reuse = (GlyphRecordRef *)calloc(count > 0 ? count : 1, sizeof(GlyphRecordRef));
+    if (!oldEntries || !reuse) {
+        fprintf(stderr, "Memory allocation error for incremental update!\n");
+        free(oldEntries);
+        free(reuse);
+        unmapFile(&oldBin);
+        return -1;
+    }
+
+    if (oldHeader.indexLayout == INDEX_LAYOUT_RANGES) {
+        // 分段布局不存码位，按段展开；没有被任何段覆盖的项按缺字处理，不会被复用
+        for (int i = 0; i < oldCount; ++i) {
+            oldEntries[i].unicode = 0;
+            oldEntries[i].offset = GLYPH_OFFSET_MISSING;
+        }
+        for (int j = 0; j < oldSegmentCount; ++j) {
+            IndexRange range;
+            memcpy(&range, indexPtr + sizeof(uint32_t) + (size_t)j * sizeof(IndexRange), sizeof(IndexRange));
+            for (int k = 0; k < range.count && range.firstSlot + k < oldCount; ++k) {
+                oldEntries[range.firstSlot + k].unicode = (uint16_t)(range.start + k);
+                memcpy(&oldEntries[range.firstSlot + k].offset,
+                       indexPtr + getIndexOffsetPosition(INDEX_LAYOUT_RANGES, oldCount, oldSegmentCount, range.firstSlot + k), sizeof(uint32_t));
+            }
+        }
+    } else if (oldHeader.indexLayout == INDEX_LAYOUT_PAGED) {
+        // 两级索引按页展开，页号和低字节拼出码位
+        const uint8_t *lowKeys = indexPtr + INDEX_PAGE_COUNT * sizeof(IndexPage);
+        for (int page = 0; page < INDEX_PAGE_COUNT; ++page) {
+            IndexPage entry;
+            memcpy(&entry, indexPtr + page * sizeof(IndexPage), sizeof(IndexPage));
+            for (int k = 0; k < entry.count; ++k) {
+                oldEntries[entry.start + k].unicode = (uint16_t)(page << 8 | lowKeys[entry.start + k]);
+            }
+        }
+        for (int i = 0; i < oldCount; ++i) {
+            memcpy(&oldEntries[i].offset, indexPtr + getIndexOffsetPosition(INDEX_LAYOUT_PAGED, oldCount, 0, i), sizeof(uint32_t));
+        }
+    } else {
+        for (int i = 0; i < oldCount; ++i) {
+            memcpy(&oldEntries[i].unicode, indexPtr + getIndexKeyPosition(oldHeader.indexLayout, i), sizeof(uint16_t));
+            memcpy(&oldEntries[i].offset, indexPtr + getIndexOffsetPosition(oldHeader.indexLayout, oldCount, oldSegmentCount, i), sizeof(uint32_t));
+        }
+    }
+    qsort(oldEntries, oldCount, sizeof(GlyphEntry), compareGlyphEntry);
+
+    for (int i = 0; reuseRecords && i < count; ++i) {
+        GlyphEntry key = { codepoints[i], 0 };
+        const GlyphEntry *found = (const GlyphEntry *)bsearch(&key, oldEntries, oldCount, sizeof(GlyphEntry), compareGlyphEntry);
+        if (!found || (found->offset & GLYPH_OFFSET_MISSING)) continue;
+
+        int recordSize = getGlyphRecordSize(oldBin.data, oldBin.size, found->offset, oldFormat, oldHeader.quantBits);
+        if (recordSize > 0) {
+            reuse[i].data = oldBin.data + found->offset;
+            reuse[i].length = (uint32_t)recordSize;
+        }
+    }
+
+    OutputBuffer out;
+    BuildCounts counts;
+    int result = buildBinFile(font, codepoints, NULL, count, reuse, &header, &updateOptions, &out, &counts);
+
+    free(oldEntries);
+    free(reuse);
+    unmapFile(&oldBin);  // 先解除映射，允许新文件覆盖旧文件
+
+    if (result == 0) {
+        result = saveBinOutput(&out, newBinPath, options);
+        outputBufferFree(&out);
+    }
+    if (result == 0) {
+        printf("[update] %s: %d glyphs reused, %d extracted (%d from cache), %d missing, %d duplicates (%u bytes saved)\n",
+               newBinPath, counts.reused, counts.extracted, counts.cached, counts.missing, counts.duplicates, counts.savedBytes);
+        if (header.quantBits) printQuantizeReport(newBinPath, &header, &counts);
+        if (fontSet) *fontSet = header;
+    }
+    return result;
+}
+
+int updateBinFileFromCharset(const stbtt_fontinfo *font, const char *oldBinPath, const char *newBinPath,
+                             const Charset *charset, FontSet *fontSet, const GenerateOptions *options) {
+    uint16_t *codepoints;
+    int count = charsetToArray(charset, &codepoints);
+    if (count < 0) {
+        fprintf(stderr, "Memory allocation error for charset!\n");
+        return -1;
+    }
+
+    int result = updateBinFileFromCodepoints(font, oldBinPath, newBinPath, codepoints, count, fontSet, options);
+    free(codepoints);
+    return result;
+}
+
+int updateBinFile(const char *ttfPath, const char *oldBinPath, const char *newBinPath, const Charset *charset, const GenerateOptions *options) {
+    LoadedFont font;
+    if (loadFontFile(&font, ttfPath) != 0) {
+        return -1;
+    }
+
+    GenerateOptions fontOptions;
+    if (options) {
+        fontOptions = *options;
+    } else {
+        initGenerateOptions(&fontOptions);
+    }
+    fontOptions.fontHash = font.hash;
+    fontOptions.glyphLookup = &font.lookup;
+
+    int result = updateBinFileFromCharset(&font.info, oldBinPath, newBinPath, charset, NULL, &fontOptions);
+    if (result == 1) {
+        fprintf(stderr, "BIN file %s was not generated from %s, full rebuild required!\n", oldBinPath, ttfPath);
+        result = -1;
+    }
+    freeLoadedFont(&font);
+    return result;
+}
+
+// 取出清单行中的下一个字段，支持用双引号包住带空格的路径；没有字段时返回 NULL
+static char *nextManifestToken(char **cursor) {
+    char *p = *cursor;
+    while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+    if (*p == '\0' || *p == '#') {
+        *cursor = p;
+        return NULL;
+    }
+
+    char *token;
+    if (*p == '"') {
+        token = ++p;
+        while (*p && *p != '"') p++;
+    } else {
+        token = p;
+        while (*p && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') p++;
+    }
+    if (*p) *p++ = '\0';
+    *cursor = p;
+    return token;
+}
+
+static void addCoveredCodepoint(uint32_t codepoint, int glyphIndex, void *user) {
+    (void)glyphIndex;
+    if (codepoint <= 0xFFFF) charsetAdd((Charset *)user, (uint16_t)codepoint);
+}
+
+// 字体覆盖的全部 BMP 字符
+void charsetAddFontCoverage(Charset *set, const stbtt_fontinfo *font) {
+    enumerateCmap(font, addCoveredCodepoint, set);
+}
+
+// 求单个字符集操作数：
+//   ascii / gb2312 / gb2312-1 / gb2312-2 / big5-common  内置字符集
+//   file:<路径>  UTF-8 文本文件中的字符；不带前缀的已存在路径同样按文本文件处理
+//   scan:<目录>  扫描语料目录
+//   font:<ttf>   该字体覆盖的全部字符
+static int evaluateCharsetOperand(const char *operand, const char *scanExtensions, Charset *set) {
+    if (strncmp(operand, "scan:", 5) == 0) {
+        const char *root = operand + 5;
+        CorpusScanStats stats;
+        if (scanCorpus(&root, 1, scanExtensions, 0, set, &stats) != 0) return -1;
+        printCorpusScanStats(root, set, &stats);
+        return 0;
+    }
+
+    if (strncmp(operand, "font:", 5) == 0) {
+        LoadedFont font;
+        if (loadFontFile(&font, operand + 5) != 0) return -1;
+        charsetAddFontCoverage(set, &font.info);
+        freeLoadedFont(&font);
+        return 0;
+    }
+
+    if (charsetAddPreset(set, operand) == 0) {
+        return 0;
+    }
+
+    const char *path = strncmp(operand, "file:", 5) == 0 ? operand + 5 : operand;
+    char *text = loadTextFile(path);
+    if (!text) {
+        fprintf(stderr, "Unknown charset %s!\n", operand);
+        return -1;
+    }
+    charsetAddUtf8Text(set, text);
+    free(text);
+    return 0;
+}
+
+// 求字符集表达式：操作数之间用空格分隔的 +（并）、-（差）、&（交）连接，从左到右计算，
+// 例如 "gb2312 - font:Quicksand_Regular.ttf + ascii"。整个表达式是已存在的文件时直接按文本文件处理
+int evaluateCharsetSpec(const char *spec, const char *scanExtensions, Charset *result) {
+    charsetClear(result);
+
+    FILE *file = fopen(spec, "rb");
+    if (file) {
+        fclose(file);
+        return evaluateCharsetOperand(spec, scanExtensions, result);
+    }
+
+    char *copy = strdup(spec);
+    Charset *operand = (Charset *)malloc(sizeof(Charset));
+    if (!copy || !operand) {
+        free(copy);
+        free(operand);
+        return -1;
+    }
+
+    int status = 0;
+    char op = '+';
+    int expectOperand = 1;
+    char *cursor = copy;
+    char *token;
+    while (status == 0 && (token = nextManifestToken(&cursor)) != NULL) {
+        int isOperator = (token[0] == '+' || token[0] == '-' || token[0] == '&') && token[1] == '\0';
+        if (expectOperand == isOperator) {
+            fprintf(stderr, "Invalid charset expression: %s\n", spec);
+            status = -1;
+            break;
+        }
+
+        if (isOperator) {
+            op = token[0];
+        } else {
+            charsetClear(operand);
+            status = evaluateCharsetOperand(token, scanExtensions, operand);
+            if (op == '+') {
+                charsetUnion(result, operand);
+            } else if (op == '-') {
+                charsetSubtract(result, operand);
+            } else {
+                charsetIntersect(result, operand);
+            }
+        }
+        expectOperand = !expectOperand;
+    }
+    if (status == 0 && expectOperand) {
+        fprintf(stderr, "Invalid charset expression: %s\n", spec);
+        status = -1;
+    }
+
+    free(operand);
+    free(copy);
+    return status;
+}
+
+// 批量任务：一行清单对应一个输出文件
+typedef struct {
+    char *ttfPath;
+    char *binPath;
+    char *charsetSpec;  // 字符集表达式，见 evaluateCharsetSpec；full 表示字体支持的全部字符
+    const Charset *charset;  // 由 runBatchManifest 求值，相同表达式的任务共享；full 时为空
+    FontSet fontSet;
+    GenerateOptions options;
+    const LoadedFont *font;
+    int incremental;  // 输出文件已存在且参数一致时增量更新
+    char *profilePath;  // 非空时保存该任务的生成统计，见 saveGenerateProfile
+    int profileTop;
+    int result;
+} BatchJob;
+
+static void initBatchFontSet(FontSet *fontSet) {
+    memset(fontSet, 0, sizeof(FontSet));
+    fontSet->fileFlag = 2;
+    memcpy(fontSet->version, FONTSET_VERSION_BASE, 4);
+    fontSet->indexMethod = INDEX_METHOD_SORTED;
+}
+
+// 索引区布局名称，下标即 INDEX_LAYOUT_*
+static const char *indexLayoutNames[] = { "interleaved", "split", "ranges", "paged" };
+
+static int parseIndexLayout(const char *name) {
+    for (int i = 0; i < (int)(sizeof(indexLayoutNames) / sizeof(indexLayoutNames[0])); ++i) {
+        if (strcmp(name, indexLayoutNames[i]) == 0) return i;
+    }
+    fprintf(stderr, "Unknown index layout %s!\n", name);
+    return -1;
+}
+
+// 轮廓编码格式名称，下标即 OUTLINE_FORMAT_*
+static const char *outlineFormatNames[] = { "raw", "delta", "curves", "quantized", "edges" };
+
+// 按名称查找轮廓编码格式，未知名称返回 -1
+static int parseOutlineFormat(const char *name) {
+    for (int i = 0; i < (int)(sizeof(outlineFormatNames) / sizeof(outlineFormatNames[0])); ++i) {
+        if (strcmp(name, outlineFormatNames[i]) == 0) return i;
+    }
+    fprintf(stderr, "Unknown outline format %s!\n", name);
+    return -1;
+}
+
+// 解析 key=value 形式的可选字段
+static int applyBatchJobOption(BatchJob *job, const char *key, const char *value) {
+    int number = atoi(value);
+    if (strcmp(key, "bold") == 0) {
+        job->fontSet.bold = number ? 1 : 0;
+    } else if (strcmp(key, "italic") == 0) {
+        job->fontSet.italic = number ? 1 : 0;
+    } else if (strcmp(key, "indexMethod") == 0) {
+        job->fontSet.indexMethod = number ? 1 : 0;
+    } else if (strcmp(key, "threads") == 0) {
+        job->options.threadCount = number;
+    } else if (strcmp(key, "incremental") == 0) {
+        job->incremental = number ? 1 : 0;
+        if (job->incremental) job->options.recordFontHash = 1;  // 下次运行才能确认字体没有变化
+    } else if (strcmp(key, "fontHash") == 0) {
+        job->options.recordFontHash = number ? 1 : 0;
+    } else if (strcmp(key, "dedup") == 0) {
+        job->options.dedupGlyphs = number ? 1 : 0;
+    } else if (strcmp(key, "checksum") == 0) {
+        job->options.checksum = number ? 1 : 0;
+    } else if (strcmp(key, "fixedPoint") == 0) {
+        job->options.fixedPointBits = number;
+    } else if (strcmp(key, "quantBits") == 0) {
+        job->options.quantBits = number;
+    } else if (strcmp(key, "simplify") == 0) {
+        job->options.simplifyTolerance = (float)atof(value);
+    } else if (strcmp(key, "outline") == 0) {
+        int format = parseOutlineFormat(value);
+        if (format < 0) return -1;
+        job->options.outlineFormat = format;
+    } else if (strcmp(key, "indexLayout") == 0) {
+        int layout = parseIndexLayout(value);
+        if (layout < 0) return -1;
+        job->options.indexLayout = layout;
+    } else if (strcmp(key, "profile") == 0) {
+        free(job->profilePath);
+        job->profilePath = strdup(value);
+        if (!job->profilePath) return -1;
+    } else if (strcmp(key, "profileTop") == 0) {
+        job->profileTop = number;
+    } else if (strcmp(key, "missing") == 0) {
+        if (strcmp(value, "empty") == 0) {
+            job->options.missingGlyphs = MISSING_GLYPH_EMPTY;
+        } else if (strcmp(value, "notdef") == 0) {
+            job->options.missingGlyphs = MISSING_GLYPH_NOTDEF;
+        } else if (strcmp(value, "omit") == 0) {
+            job->options.missingGlyphs = MISSING_GLYPH_OMIT;
+        } else {
+            return -1;
+        }
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+void freeBatchJobs(BatchJob *jobs, int jobCount) {
+    for (int i = 0; i < jobCount; ++i) {
+        free(jobs[i].ttfPath);
+        free(jobs[i].binPath);
+        free(jobs[i].charsetSpec);
+        free(jobs[i].profilePath);
+    }
+    free(jobs);
+}
+
+// 解析批量清单，每行格式：
+//   <ttf文件> <输出bin> <fontSize> <renderMode> <字符集> [key=value ...]
+// '#' 之后为注释，空行忽略
+int parseBatchManifest(const char *manifestPath, const GenerateOptions *defaults, BatchJob **outJobs, int *outJobCount) {
+    FILE *file = fopen(manifestPath, "r");
+    if (!file) {
+        fprintf(stderr, "Error opening manifest %s!\n", manifestPath);
+        return -1;
+    }
+
+    BatchJob *jobs = NULL;
+    int jobCount = 0;
+    int capacity = 0;
+    int lineNumber = 0;
+    char line[4096];
+
+    while (fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        char *cursor = line;
+        char *fields[5];
+        int fieldCount = 0;
+        while (fieldCount < 5 && (fields[fieldCount] = nextManifestToken(&cursor)) != NULL) {
+            fieldCount++;
+        }
+        if (fieldCount == 0) continue;
+        if (fieldCount < 5) {
+            fprintf(stderr, "%s:%d: expected <ttf> <bin> <fontSize> <renderMode> <charset>!\n", manifestPath, lineNumber);
+            goto fail;
+        }
+
+        if (jobCount == capacity) {
+            capacity = capacity ? capacity * 2 : 16;
+            BatchJob *newJobs = (BatchJob *)realloc(jobs, capacity * sizeof(BatchJob));
+            if (!newJobs) {
+                fprintf(stderr, "Memory allocation error for batch jobs!\n");
+                goto fail;
+            }
+            jobs = newJobs;
+        }
+
+        BatchJob *job = &jobs[jobCount++];
+        memset(job, 0, sizeof(BatchJob));
+        initBatchFontSet(&job->fontSet);
+        job->options = *defaults;
+        job->ttfPath = strdup(fields[0]);
+        job->binPath = strdup(fields[1]);
+        job->charsetSpec = strdup(fields[4]);
+        job->fontSet.fontSize = (char)atoi(fields[2]);
+        job->fontSet.renderMode = (char)atoi(fields[3]);
+        job->profileTop = 10;
+
+        if (!job->ttfPath || !job->binPath || !job->charsetSpec) {
+            fprintf(stderr, "Memory allocation error for batch jobs!\n");
+            goto fail;
+        }
+        if (job->fontSet.fontSize <= 0 || job->fontSet.renderMode <= 0) {
+            fprintf(stderr, "%s:%d: invalid fontSize or renderMode!\n", manifestPath, lineNumber);
+            goto fail;
+        }
+
+        char *option;
+        while ((option = nextManifestToken(&cursor)) != NULL) {
+            char *equals = strchr(option, '=');
+            if (equals) *equals = '\0';
+            if (!equals || applyBatchJobOption(job, option, equals + 1) != 0) {
+                fprintf(stderr, "%s:%d: unknown option %s!\n", manifestPath, lineNumber, option);
+                goto fail;
+            }
+        }
+    }
+
+    fclose(file);
+    *outJobs = jobs;
+    *outJobCount = jobCount;
+    return 0;
+
+fail:
+    fclose(file);
+    freeBatchJobs(jobs, jobCount);
+    return -1;
+}
+
+typedef struct {
+    BatchJob *jobs;
+    int jobCount;
+    int nextJob;
+    Mutex lock;
+} BatchQueue;
+
+void runBatchJob(BatchJob *job) {
+    // 字符集为 full 时遍历 cmap 全量导出，字形随码位一起给出
+    FontCoverage coverage;
+    if (!job->charset) {
+        if (getFontCoverage(&job->font->lookup, &coverage) != 0) {
+            job->result = -1;
+            return;
+        }
+    } else {
+        memset(&coverage, 0, sizeof(FontCoverage));
+        coverage.count = charsetToArray(job->charset, &coverage.codepoints);
+        if (coverage.count < 0) {
+            job->result = -1;
+            return;
+        }
+    }
+    uint16_t *codepoints = coverage.codepoints;
+    int count = coverage.count;
+
+    GenerateProfile profile;
+    memset(&profile, 0, sizeof(GenerateProfile));
+    job->options.profile = job->profilePath ? &profile : NULL;
+
+    job->result = 1;
+    FILE *existing = job->incremental ? fopen(job->binPath, "rb") : NULL;
+    if (existing) {
+        fclose(existing);
+        job->result = updateBinFileFromCodepoints(&job->font->info, job->binPath, job->binPath, codepoints, count, &job->fontSet, &job->options);
+    }
+    if (job->result == 1) {
+        job->result = generateBinFileFromGlyphs(&job->font->info, job->binPath, codepoints, coverage.glyphIndices, count, &job->fontSet, &job->options);
+    }
+    freeFontCoverage(&coverage);
+    if (job->result == 0 && job->profilePath) {
+        job->result = saveGenerateProfile(&profile, job->binPath, job->profileTop, job->profilePath);
+    }
+    freeGenerateProfile(&profile);
+    job->options.profile = NULL;
+
+    if (job->result == 0) {
+        printf("[batch] %s <- %s (%dpx, renderMode %d, %s)\n", job->binPath, job->ttfPath,
+               job->fontSet.fontSize, job->fontSet.renderMode, job->charsetSpec);
+    } else {
+        fprintf(stderr, "[batch] failed: %s\n", job->binPath);
+    }
+}
+
+void batchWorker(void *arg) {
+    BatchQueue *queue = *(BatchQueue **)arg;
+    for (;;) {
+        mutexLock(&queue->lock);
+        int jobIndex = queue->nextJob++;
+        mutexUnlock(&queue->lock);
+
+        if (jobIndex >= queue->jobCount) break;
+        runBatchJob(&queue->jobs[jobIndex]);
+    }
+}
+
+// 并发执行一组已绑定字体的任务，返回失败的任务数
+int runBatchJobs(BatchJob *jobs, int jobCount, int threadCount) {
+    if (threadCount <= 0) threadCount = getCpuCount();
+    if (threadCount > jobCount) threadCount = jobCount;
+
+    BatchQueue queue = { .jobs = jobs, .jobCount = jobCount, .nextJob = 0 };
+    mutexInit(&queue.lock);
+
+    BatchQueue **args = (BatchQueue **)malloc((threadCount > 0 ? threadCount : 1) * sizeof(BatchQueue *));
+    if (!args) {
+        mutexDestroy(&queue.lock);
+        return jobCount;
+    }
+    for (int i = 0; i < threadCount; ++i) args[i] = &queue;
+    runParallel(batchWorker, args, sizeof(BatchQueue *), threadCount);
+    free(args);
+    mutexDestroy(&queue.lock);
+
+    int failed = 0;
+    for (int i = 0; i < jobCount; ++i) {
+        if (jobs[i].result != 0) failed++;
+    }
+    return failed;
+}
+
+// 批量模式入口：解析清单，每个 TTF 只加载一次，然后并发执行所有任务。
+// defaults 为每个任务的初始生成选项，清单中的 key=value 在其基础上覆盖；
+// scanExtensions 为字符集表达式中 scan: 的扩展名过滤，可为空
+int runBatchManifest(const char *manifestPath, int threadCount, const GenerateOptions *defaults, const char *scanExtensions) {
+    BatchJob *jobs = NULL;
+    int jobCount = 0;
+    if (parseBatchManifest(manifestPath, defaults, &jobs, &jobCount) != 0) {
+        return -1;
+    }
+
+    LoadedFont *fonts = (LoadedFont *)calloc(jobCount > 0 ? jobCount : 1, sizeof(LoadedFont));
+    int fontCount = 0;
+    int failed = 0;
+    if (!fonts) {
+        fprintf(stderr, "Memory allocation error for fonts!\n");
+        freeBatchJobs(jobs, jobCount);
+        return -1;
+    }
+
+    for (int i = 0; i < jobCount; ++i) {
+        int f = 0;
+        while (f < fontCount && strcmp(fonts[f].path, jobs[i].ttfPath) != 0) f++;
+        if (f == fontCount) {
+            if (loadFontFile(&fonts[fontCount], jobs[i].ttfPath) != 0) {
+                failed = 1;
+                break;
+            }
+            fontCount++;
+        }
+        jobs[i].font = &fonts[f];
+        jobs[i].options.fontHash = fonts[f].hash;
+        jobs[i].options.glyphLookup = &fonts[f].lookup;
+    }
+
+    // 每个不同的字符集表达式只求值一次（语料只扫描一次），由所有引用它的任务共享
+    Charset **charsets = (Charset **)calloc(jobCount > 0 ? jobCount : 1, sizeof(Charset *));
+    if (!charsets) failed = 1;
+    for (int i = 0; !failed && i < jobCount; ++i) {
+        if (strcmp(jobs[i].charsetSpec, "full") == 0) continue;
+
+        int j = 0;
+        while (j < i && strcmp(jobs[j].charsetSpec, jobs[i].charsetSpec) != 0) j++;
+        if (j < i) {
+            jobs[i].charset = charsets[j];
+            continue;
+        }
+
+        charsets[i] = (Charset *)malloc(sizeof(Charset));
+        if (!charsets[i] || evaluateCharsetSpec(jobs[i].charsetSpec, scanExtensions, charsets[i]) != 0) {
+            failed = 1;
+            break;
+        }
+        jobs[i].charset = charsets[i];
+    }
+
+    if (!failed) {
+        failed = runBatchJobs(jobs, jobCount, threadCount);
+        printf("[batch] %d jobs, %d fonts, %d failed\n", jobCount, fontCount, failed);
+    }
+
+    for (int f = 0; f < fontCount; ++f) {
+        freeLoadedFont(&fonts[f]);
+    }
+    for (int i = 0; charsets && i < jobCount; ++i) {
+        free(charsets[i]);
+    }
+    free(charsets);
+    free(fonts);
+    freeBatchJobs(jobs, jobCount);
+    return failed ? -1 : 0;
+}
+
+int main(int argc, char **argv) {
+    // 通用选项：--threads N  --cache <目录>  --cache-max-mb N  --ext <扩展名列表>  --no-dedup  --omit-missing  --notdef-missing  --checksum  --no-checksum
+    //           --font-hash（头部记录 TTF 内容哈希，供之后的 --update 复用字形）
+    //           --outline raw|delta|curves|quantized|edges  --quant-bits N  --simplify <像素容差>  --fixed-point <小数位数>
+    //           --index-layout interleaved|split|ranges|paged
+    //           --profile <统计文件.json|.csv>  --profile-top N（仅 --full、--update）
+    GenerateOptions options;
+    initGenerateOptions(&options);
+    int threadCount = 0;
+    const char *cacheDirectory = NULL;
+    long cacheMaxMb = 0;
+    const char *scanExtensions = NULL;
+    const char *profilePath = NULL;
+    int profileTop = 10;
+    char *args[64];
+    int argCount = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            cacheDirectory = argv[++i];
+        } else if (strcmp(argv[i], "--cache-max-mb") == 0 && i + 1 < argc) {
+            cacheMaxMb = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--ext") == 0 && i + 1 < argc) {
+            scanExtensions = argv[++i];
+        } else if (strcmp(argv[i], "--no-dedup") == 0) {
+            options.dedupGlyphs = 0;
+        } else if (strcmp(argv[i], "--checksum") == 0) {
+            options.checksum = 1;
+        } else if (strcmp(argv[i], "--no-checksum") == 0) {
+            options.checksum = 0;
+        } else if (strcmp(argv[i], "--font-hash") == 0) {
+            options.recordFontHash = 1;
+        } else if (strcmp(argv[i], "--omit-missing") == 0) {
+            options.missingGlyphs = MISSING_GLYPH_OMIT;
+        } else if (strcmp(argv[i], "--notdef-missing") == 0) {
+            options.missingGlyphs = MISSING_GLYPH_NOTDEF;
+        } else if (strcmp(argv[i], "--fixed-point") == 0 && i + 1 < argc) {
+            options.fixedPointBits = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--quant-bits") == 0 && i + 1 < argc) {
+            options.quantBits = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--simplify") == 0 && i + 1 < argc) {
+            options.simplifyTolerance = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--outline") == 0 && i + 1 < argc) {
+            int format = parseOutlineFormat(argv[++i]);
+            if (format < 0) return 1;
+            options.outlineFormat = format;
+        } else if (strcmp(argv[i], "--index-layout") == 0 && i + 1 < argc) {
+            int layout = parseIndexLayout(argv[++i]);
+            if (layout < 0) return 1;
+            options.indexLayout = layout;
+        } else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            profilePath = argv[++i];
+        } else if (strcmp(argv[i], "--profile-top") == 0 && i + 1 < argc) {
+            profileTop = atoi(argv[++i]);
+        } else if (argCount < 64) {
+            args[argCount++] = argv[i];
+        }
+    }
+
+    GlyphCache cache;
+    if (cacheDirectory) {
+        if (glyphCacheOpen(&cache, cacheDirectory, (uint64_t)cacheMaxMb * 1024 * 1024) != 0) return 1;
+        options.glyphCache = &cache;
+    }
+
+    int commandResult = -2;
+    GenerateProfile profile;
+    const char *profileBinPath = NULL;
+    memset(&profile, 0, sizeof(GenerateProfile));
+    if (argCount >= 2 && strcmp(args[0], "--batch") == 0) {
+        // 批量模式：ttf2bin --batch <清单文件>，--threads 为同时执行的任务数
+        commandResult = runBatchManifest(args[1], threadCount, &options, scanExtensions);
+    } else if (argCount >= 4 && strcmp(args[0], "--update") == 0) {
+        // 增量更新：ttf2bin --update <ttf文件> <已有bin> <字符集> [输出bin]，--threads 为提取线程数
+        options.threadCount = threadCount;
+        options.profile = profilePath ? &profile : NULL;
+        Charset *charset = (Charset *)malloc(sizeof(Charset));
+        commandResult = -1;
+        if (charset && evaluateCharsetSpec(args[3], scanExtensions, charset) == 0) {
+            profileBinPath = argCount >= 5 ? args[4] : args[2];
+            commandResult = updateBinFile(args[1], args[2], profileBinPath, charset, &options);
+        }
+        free(charset);
+    } else if (argCount >= 3 && strcmp(args[0], "--full") == 0) {
+        // 全量导出：ttf2bin --full <ttf文件> <输出bin> [fontSize] [renderMode]，导出字体支持的全部 BMP 字符
+        LoadedFont font;
+        FontSet fullFontSet;
+        initBatchFontSet(&fullFontSet);
+        fullFontSet.fontSize = (char)(argCount >= 4 ? atoi(args[3]) : 32);
+        fullFontSet.renderMode = (char)(argCount >= 5 ? atoi(args[4]) : 4);
+        options.threadCount = threadCount;
+        options.profile = profilePath ? &profile : NULL;
+        profileBinPath = args[2];
+        commandResult = -1;
+        if (fullFontSet.fontSize <= 0 || fullFontSet.renderMode <= 0) {
+            fprintf(stderr, "Invalid fontSize or renderMode!\n");
+        } else if (loadFontFile(&font, args[1]) == 0) {
+            options.fontHash = font.hash;
+            options.glyphLookup = &font.lookup;
+            commandResult = generateBinFileFullCoverage(&font.info, args[2], &fullFontSet, &options);
+            freeLoadedFont(&font);
+        }
+    } else if (argCount >= 2 && strcmp(args[0], "--verify") == 0) {
+        // 完整性检查：ttf2bin --verify <bin>...，按挂载流程校验校验和与全部索引项
+        commandResult = 0;
+        for (int i = 1; i < argCount; ++i) {
+            MountedBin bin;
+            if (mountBinFile(&bin, args[i], MOUNT_VERIFY_CHECKSUM) != 0) {
+                commandResult = -1;
+                continue;
+            }
+            printf("[verify] %s: %d entries, %s\n", args[i], bin.entryCount, bin.hasChecksum ? "checksum OK" : "no checksum");
+            unmountBin(&bin);
+        }
+    } else if (argCount >= 3 && strcmp(args[0], "--charset") == 0) {
+        // 字符集求值：ttf2bin --charset <输出字符集文件> <字符集表达式>
+        Charset *charset = (Charset *)malloc(sizeof(Charset));
+        commandResult = -1;
+        if (charset && evaluateCharsetSpec(args[2], scanExtensions, charset) == 0) {
+            printf("[charset] %s: %d characters\n", args[1], charsetCount(charset));
+            commandResult = charsetSaveUtf8(charset, args[1]);
+        }
+        free(charset);
+    } else if (argCount >= 3 && strcmp(args[0], "--scan") == 0) {
+        // 语料扫描：ttf2bin --scan <输出字符集文件> <目录或文件>... [--ext .txt,.json]
+        Charset *charset = (Charset *)calloc(1, sizeof(Charset));
+        CorpusScanStats stats;
+        commandResult = -1;
+        if (charset && scanCorpus((const char *const *)&args[2], argCount - 2, scanExtensions, threadCount, charset, &stats) == 0) {
+            printCorpusScanStats(args[1], charset, &stats);
+            commandResult = charsetSaveUtf8(charset, args[1]);
+        }
+        free(charset);
+    }
+
+    if (commandResult == 0 && options.profile) {
+        printGenerateProfile(&profile, profileBinPath, profileTop);
+        commandResult = saveGenerateProfile(&profile, profileBinPath, profileTop, profilePath);
+    }
+    freeGenerateProfile(&profile);
+
+    if (options.glyphCache) glyphCacheClose(&cache);
+    if (commandResult != -2) {
+        return commandResult == 0 ? 0 : 1;
+    }
+
+    FontSet fontSet = {
+        .fileFlag = 2,
+        .version = { '1', '0', '0', '4' },
+        .fontSize = 32,
+        .renderMode = 4,
+        .bold = 0,
+        .italic = 0,
+        .scanMode = 0,
+        .indexMethod = INDEX_METHOD_SORTED,
+        .indexAreaSize = 0,
+        .fontNameLength = 0,
+        .ascent = 0,
+        .descent = 0,
+        .lineGap = 0,
+        .fontName = NULL
+    };
+
+    /*ascii, CP500*/
+    const char *ascii = "!\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
+    const char *twgx = "滕王高阁临江渚，佩玉鸣鸾罢歌舞。画栋朝飞南浦云，珠帘暮卷西山雨。闲云潭影日悠悠，物换星移几度秋。阁中帝子今何在？槛外长江空自流。";
+    const char *twgx_ascii = "滕王高阁临江渚，佩玉鸣鸾罢歌舞。画栋朝飞南浦云，珠帘暮卷西山雨。闲云潭影日悠悠，物换星移几度秋。阁中帝子今何在？槛外长江空自流。!\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
+
+    const char *binname = "harmony_32_4.bin";
+    int result = generateBinFile("HarmonyOS_Sans_SC_Regular.ttf", binname, ascii, &fontSet);
+    // STXihei.ttf
+    // STXINGKA.TTF
+    // HarmonyOS_Sans_SC_Regular.ttf
+    if (result == 0) {
+        readBinFile(binname);
+    }
+
+    const char *binFilePath = binname;
+    // uint16_t unicode = 0x738B;  // 例如：Unicode字符"王"
+
+    // int offset = getGlyphOffsetFromBinFile(unicode, binFilePath);
+    // if (offset) {
+    //     printf("Glyph offset for Unicode 0x%X is %d\n", unicode, offset);
+    // } else {
+    //     printf("Unicode 0x%X not found in the file.\n", unicode);
+    // }
+
+    int fileLength = 0;    // 将文件加载到内存中
+    uint8_t *memoryBuffer = loadFileToMemory(binFilePath, &fileLength);
+    if (!memoryBuffer) {
+        return -1;
+    }
+
+    uint16_t unicode = 0x738B;  // 例如：Unicode字符"王"
+    int offset = getGlyphOffsetFromMemory(unicode, memoryBuffer);
+    if (offset) {
+        printf("Glyph offset for Unicode 0x%X is %d\n", unicode, offset);
+
+        FontGlyphData glyphData;
+        if (readFontGlyphData(memoryBuffer, offset, &glyphData) == 0) {
+            // 打印基本数据以验证
+            printf("sx0: %d, sy0: %d, sx1: %d, sy1: %d\n",
+                   glyphData.sx0, glyphData.sy0, glyphData.sx1, glyphData.sy1);
+            printf("winding_count: %d\n", glyphData.winding_count);
+
+            // 打印 winding_lengths
+            printf("winding_lengths:");
+            for (int i = 0; i < glyphData.winding_count; ++i) {
+                printf(" %d", glyphData.winding_lengths[i]);
+            }
+            printf("\n");
+
+            // 打印 windings (x, y)
+            printf("windings:");
+            int line_count = 0;
+            for (int i = 0; i < glyphData.winding_count; ++i) {
+                line_count += glyphData.winding_lengths[i];
+            }
+            for (int i = 0; i < line_count; ++i) {
+                printf(" (%d, %d)", glyphData.windings[2 * i], glyphData.windings[2 * i + 1]);
+            }
+            printf("\n");
+
+            // 释放分配的内存
+            free(glyphData.winding_lengths);
+            free(glyphData.windings);
+        }
+    } else {
+        printf("Unicode 0x%X not found in memory.\n", unicode);
+    }
+
+
+    free(memoryBuffer);
+    return 0;
+}
+